@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Assumed size of a CPU cache line, used to align compiled data
+	 * so that evaluating a segment touches a single line.
+	 */
+	constexpr size_t CACHE_LINE_SIZE = 64;
+
+	/*
+	 * A curve segment flattened into the power basis, ready for
+	 * evaluation with the Horner scheme:
+	 * P(t) = ( ( a * t + b ) * t + c ) * t + d
+	 *
+	 * The Y-axis of these coefficients is also used for the
+	 * evaluation by time, since both share the same polynomial.
+	 */
+	struct alignas( CACHE_LINE_SIZE ) CompiledSegment
+	{
+		Point a, b, c, d;
+
+		/*
+		 * Time (X-axis) of the segment's first control point.
+		 */
+		float start_time;
+		/*
+		 * Inverse of the time difference between both control
+		 * points, or 0.0f if the segment has no time extent.
+		 */
+		float inv_time_diff;
+	};
+
+	/*
+	 * An immutable and evaluation-only representation of a curve,
+	 * produced by 'Curve::compile'.
+	 *
+	 * Contrary to 'Curve', it does not know about point indices,
+	 * tangent modes or dirty flags: it only stores flat segment
+	 * coefficients, key times and precomputed data such as the
+	 * length and the extrems.
+	 *
+	 * Evaluation methods do not check their inputs nor the curve
+	 * validity outside of debug builds (using 'assert').
+	 */
+	class CompiledCurve
+	{
+	public:
+		CompiledCurve();
+		explicit CompiledCurve( const Curve& curve );
+
+		/*
+		 * Evaluate a curve point at given percent, in range from
+		 * 0.0f to 1.0f.
+		 */
+		Point evaluate_by_percent( float t ) const;
+		/*
+		 * Evaluate a curve point at given distance.
+		 */
+		Point evaluate_by_distance( float dist ) const;
+		/*
+		 * Evaluate the Y-axis value corresponding to the given
+		 * time on the X-axis.
+		 */
+		float evaluate_by_time( float time ) const;
+		/*
+		 * Evaluate the Y-axis values corresponding to an array of
+		 * times, using 'CurveKernels'. Both arrays must hold
+		 * 'count' elements.
+		 */
+		void evaluate_by_time(
+			const float* times,
+			float* values,
+			int count
+		) const;
+		/*
+		 * Evaluate 'count' points at evenly spaced percents, from
+		 * the start to the end of the curve, using 'CurveKernels'.
+		 */
+		void tessellate( int count, Point* points ) const;
+
+		/*
+		 * Returns the index of the segment to evaluate from at
+		 * given time.
+		 */
+		int find_segment_id_by_time( float time ) const;
+
+		/*
+		 * Returns the precomputed length of the curve.
+		 */
+		float get_length() const;
+		/*
+		 * Returns the precomputed coordinates extrems of all
+		 * points.
+		 */
+		const CurveExtrems& get_extrems() const;
+
+		/*
+		 * Returns the time (X-axis) of the given key index.
+		 * The index must refer to a valid key.
+		 */
+		float get_key_time( int key_id ) const;
+		/*
+		 * Returns the segment at the given index.
+		 * The index must refer to a valid segment.
+		 */
+		const CompiledSegment& get_segment( int curve_id ) const;
+
+		/*
+		 * Returns the number of keys the curve was compiled from.
+		 */
+		int get_keys_count() const;
+		/*
+		 * Returns the number of segments.
+		 */
+		int get_curves_count() const;
+
+		/*
+		 * Returns whenever the compiled curve holds at least one
+		 * segment to evaluate.
+		 */
+		bool is_valid() const;
+
+	private:
+		/*
+		 * Segments coefficients, one per cache line.
+		 */
+		std::vector<CompiledSegment> _segments;
+		/*
+		 * Time of each key, contiguous for the binary search.
+		 */
+		std::vector<float> _times;
+
+		Point _first_point;
+		Point _last_point;
+
+		float _length = 0.0f;
+		CurveExtrems _extrems {};
+	};
+}
\ No newline at end of file
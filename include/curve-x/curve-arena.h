@@ -0,0 +1,82 @@
+#pragma once
+
+#include <deque>
+#include <memory_resource>
+#include <string>
+
+#include "curve.h"
+#include "curve-serializer.h"
+
+namespace curve_x
+{
+	/*
+	 * Default size of the first buffer allocated by an arena.
+	 */
+	constexpr size_t ARENA_INITIAL_SIZE = 16 * 1024;
+
+	/*
+	 * Container owning a set of curves whose keys are allocated
+	 * inside a single monotonic memory arena.
+	 *
+	 * It is intended for bulk-loaded curves (e.g. all the curves of
+	 * a level): allocations are contiguous and cheap, and all of
+	 * them are freed at once on 'release'.
+	 *
+	 * Since memory is never reclaimed before 'release', curves
+	 * that are frequently edited should not be stored inside an
+	 * arena.
+	 */
+	class CurveArena
+	{
+	public:
+		CurveArena( size_t initial_size = ARENA_INITIAL_SIZE );
+
+		CurveArena( const CurveArena& ) = delete;
+		CurveArena& operator=( const CurveArena& ) = delete;
+
+		/*
+		 * Create an empty curve inside the arena.
+		 *
+		 * The returned reference stays valid until 'release'.
+		 */
+		Curve& create_curve();
+		/*
+		 * Un-serialize the given string data into a curve inside
+		 * the arena.
+		 *
+		 * The returned reference stays valid until 'release'.
+		 */
+		Curve& unserialize( const std::string& data );
+
+		/*
+		 * Get a reference to the curve at given index.
+		 * The index must refer to a valid curve.
+		 */
+		Curve& get_curve( int curve_id );
+		/*
+		 * Returns the number of curves inside the arena.
+		 */
+		int get_curves_count() const;
+
+		/*
+		 * Destroy all curves and free the arena memory in one go.
+		 */
+		void release();
+
+		/*
+		 * Returns the memory resource of the arena.
+		 */
+		std::pmr::memory_resource* get_memory_resource();
+
+	private:
+		std::pmr::monotonic_buffer_resource _resource;
+
+		/*
+		 * Curves objects, stored inside a deque so that references
+		 * stay valid while adding curves.
+		 */
+		std::deque<Curve> _curves;
+
+		CurveSerializer _serializer;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Helper class evaluating the weighted sum of several curves
+	 * by time, as done by animation blend trees.
+	 *
+	 * When all curves share the same key times, they are aligned:
+	 * a single segment search is done and their segments are
+	 * summed before a single Bézier evaluation. Otherwise, sorted
+	 * times are evaluated by walking the segments of each curve in
+	 * lockstep with a cursor per curve, instead of searching them.
+	 *
+	 * Weights are not normalized. Curves are not owned and must
+	 * outlive the blender. After editing a curve, 'update' must
+	 * be called to check again whenever curves are aligned.
+	 */
+	class CurveBlender
+	{
+	public:
+		CurveBlender();
+		CurveBlender(
+			const Curve* const* curves,
+			const float* weights,
+			int count
+		);
+
+		/*
+		 * Add a curve to blend with the given weight.
+		 * The curve must have at least one key.
+		 */
+		void add_curve( const Curve* curve, float weight );
+		/*
+		 * Remove all curves.
+		 */
+		void clear();
+
+		/*
+		 * Set the weight of the curve at given index.
+		 * The index must refer to a valid curve.
+		 */
+		void set_weight( int input_id, float weight );
+		/*
+		 * Returns the weight of the curve at given index.
+		 * The index must refer to a valid curve.
+		 */
+		float get_weight( int input_id ) const;
+
+		/*
+		 * Check again whenever the curves are aligned, to call
+		 * after editing their keys.
+		 */
+		void update();
+
+		/*
+		 * Evaluate the blended value at given time.
+		 */
+		float evaluate_by_time( float time ) const;
+		/*
+		 * Evaluate the blended values at given times, faster when
+		 * times are sorted in ascending order.
+		 */
+		void evaluate_by_time(
+			const float* times,
+			float* values,
+			int count
+		) const;
+
+		/*
+		 * Bake the blend, with its current weights, into a new
+		 * curve evaluating by time to the same values.
+		 *
+		 * Keys are placed at all the key times of the curves, and
+		 * each segment is the weighted sum of the curves segments
+		 * split at these times with De Casteljau's algorithm.
+		 * Jumps of constant segments blended with non-constant
+		 * ones are kept by two keys at the same time.
+		 */
+		Curve bake() const;
+
+		/*
+		 * Returns whenever all curves share the same key times.
+		 */
+		bool is_aligned() const;
+		/*
+		 * Returns the number of blended curves.
+		 */
+		int get_curves_count() const;
+
+	private:
+		/*
+		 * Evaluate aligned curves at given time, from the given
+		 * segment index.
+		 */
+		float _evaluate_aligned( int curve_id, float time ) const;
+
+	private:
+		std::vector<const Curve*> _curves;
+		std::vector<float> _weights;
+
+		bool _is_aligned = true;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Helper class aiming to export curves as C++ code, in order
+	 * to embed them directly inside an executable.
+	 *
+	 * Generated headers declare, for each curve:
+	 * - '<name>_keys': a 'std::array' of keys, usable to fill a
+	 *   'Curve' with 'assign_keys' or 'insert_keys'
+	 * - '<name>': a 'FixedCurve' built from these keys, if the
+	 *   curve holds at least 2 keys
+	 * - '<name>_length': the precomputed length of the curve
+	 *
+	 * All of them are 'inline constexpr' so that they live once in
+	 * read-only memory, shared by all files including the header,
+	 * and do not require any loading. Generated headers thus need
+	 * C++17.
+	 */
+	class CurveCodeGenerator
+	{
+	public:
+		/*
+		 * Construct a generator putting the declarations inside
+		 * the given namespace, or in the global namespace if empty.
+		 */
+		CurveCodeGenerator( const std::string& namespace_name = "" );
+
+		/*
+		 * Generates a complete header file declaring the given
+		 * curves with the associated names.
+		 *
+		 * Both vectors must be of the same size and names must be
+		 * valid C++ identifiers, see 'to_identifier'.
+		 */
+		std::string generate_header(
+			const std::vector<Curve>& curves,
+			const std::vector<std::string>& names
+		);
+		/*
+		 * Generates the declarations of a single curve.
+		 */
+		std::string generate( const Curve& curve, const std::string& name );
+
+		/*
+		 * Converts any string (e.g. a file name) into a valid C++
+		 * identifier by replacing invalid characters with
+		 * underscores.
+		 */
+		static std::string to_identifier( const std::string& str );
+
+	private:
+		/*
+		 * Converts a float into a literal which, once compiled,
+		 * gives back the exact same float.
+		 */
+		std::string _to_literal( float value );
+		/*
+		 * Converts a point into a brace-initializer literal.
+		 */
+		std::string _to_literal( const Point& point );
+
+	private:
+		std::string _namespace_name;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Default maximum distance allowed between the samples and
+	 * a fitted curve.
+	 */
+	constexpr float FITTING_TOLERANCE = 0.01f;
+
+	/*
+	 * Helper class converting dense sample data, such as recorded
+	 * paths or input responses, into a compact curve.
+	 *
+	 * Each segment is fitted by least squares with fixed tangent
+	 * directions. Keys are adaptively added at the sample of
+	 * maximum error, until all samples are within the tolerance.
+	 *
+	 * Tangents of the keys satisfy the given tangent mode:
+	 * - 'Broken': directions are estimated on each side of a key,
+	 *   allowing sharp corners
+	 * - 'Aligned': directions are estimated across a key and
+	 *   shared by both tangents, with lengths fitted separately
+	 * - 'Mirrored': same as 'Aligned', then both lengths are set
+	 *   to the shortest one, splitting again the segments which
+	 *   are no longer within the tolerance
+	 */
+	class CurveFitter
+	{
+	public:
+		CurveFitter(
+			float tolerance = FITTING_TOLERANCE,
+			TangentMode tangent_mode = TangentMode::Aligned
+		);
+
+		/*
+		 * Fit a geometrical shape going through the given points,
+		 * in order, from the first one to the last one.
+		 *
+		 * The error is the distance between a point and its
+		 * nearest location on the curve, the points being
+		 * parameterized by chord length and refined with Newton's
+		 * method.
+		 */
+		Curve fit( const Point* points, int count );
+		/*
+		 * Fit a timed-based curve going through the given points,
+		 * sorted by time on the X-axis.
+		 *
+		 * The error is the difference on the Y-axis with the curve
+		 * evaluated by time. Tangents X-axis are set to a third of
+		 * their segment duration.
+		 */
+		Curve fit_by_time( const Point* points, int count );
+
+		/*
+		 * Returns the maximum error of the last fitted curve.
+		 */
+		float get_max_error() const;
+
+	private:
+		/*
+		 * A fitted part of the samples, between two keys.
+		 */
+		struct FittedSegment
+		{
+			FittedSegment( int first_id, int last_id )
+				: first_id( first_id ), last_id( last_id ) {}
+
+			int first_id, last_id;
+
+			/*
+			 * Right tangent of the first key.
+			 */
+			Point right_tangent;
+			/*
+			 * Left tangent of the last key.
+			 */
+			Point left_tangent;
+
+			float max_error = 0.0f;
+			int max_error_id = 0;
+		};
+
+		Curve _fit( const Point* points, int count, bool is_by_time );
+
+		/*
+		 * Fit the tangents of the given segment and compute its
+		 * error.
+		 */
+		void _fit_segment( FittedSegment* segment );
+		void _fit_segment_by_time( FittedSegment* segment );
+		/*
+		 * Set the parameters of the samples of the given segment
+		 * by their cumulated distance, as used by 'fit'.
+		 */
+		void _parameterize_by_chord_length( const FittedSegment& segment );
+		/*
+		 * Compute the error of the given segment with its current
+		 * tangents.
+		 */
+		void _compute_segment_error( FittedSegment* segment );
+
+		/*
+		 * Estimate the unit tangent direction at the given sample
+		 * index, pointing inside the segment starting or ending
+		 * at this sample.
+		 */
+		Point _estimate_direction( int sample_id, bool is_segment_start ) const;
+		/*
+		 * Estimate the slope at the given sample index, as used
+		 * by 'fit_by_time'.
+		 */
+		float _estimate_slope( int sample_id, bool is_segment_start ) const;
+
+		/*
+		 * Set the tangents of each key shared by two segments to
+		 * the same length, for 'TangentMode::Mirrored'.
+		 */
+		void _mirror_tangents();
+
+	private:
+		float _tolerance;
+		TangentMode _tangent_mode;
+
+		/*
+		 * Data of the fit in progress.
+		 */
+		const Point* _points = nullptr;
+		int _count = 0;
+		bool _is_by_time = false;
+		std::vector<float> _parameters;
+		std::vector<FittedSegment> _segments;
+
+		float _max_error = 0.0f;
+	};
+}
\ No newline at end of file
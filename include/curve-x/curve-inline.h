@@ -0,0 +1,196 @@
+#pragma once
+
+#include "curve.h"
+
+/*
+ * Definitions of the evaluation and lookup methods of 'Curve'.
+ *
+ * By default, this file is compiled inside the library only, which
+ * defines 'CURVE_X_COMPILING_HOT_PATHS' before including it. If
+ * 'CURVE_X_INLINE_HOT_PATHS' is defined, it is instead included by
+ * 'curve.h' so that these methods can be inlined inside the user's
+ * code without relying on link-time optimizations.
+ *
+ * Including it otherwise would define these methods again in the
+ * user's code, clashing with the library at link time.
+ */
+#if defined( CURVE_X_INLINE_HOT_PATHS )
+#define CURVE_X_INLINE inline
+#elif defined( CURVE_X_COMPILING_HOT_PATHS )
+#define CURVE_X_INLINE
+#else
+#error "'curve-inline.h' must not be included directly, include 'curve.h' instead"
+#endif
+
+namespace curve_x
+{
+	CURVE_X_INLINE Point Curve::evaluate_by_percent( float t ) const
+	{
+		int first_key_id, last_key_id;
+		find_evaluation_keys_id_by_percent( 
+			&first_key_id, &last_key_id, t );
+		//t = fmaxf( fminf( t, 1.0f ), 0.0f );
+
+		const CurveKey& k0 = get_key( first_key_id );
+		const CurveKey& k1 = get_key( last_key_id );
+
+		const Point& p0 = k0.control;
+		const Point& p3 = k1.control;
+
+		//  Skip the cubic math for simpler segments
+		switch ( k0.interpolation_mode )
+		{
+			case InterpolationMode::Constant:
+				return t < 1.0f ? p0 : p3;
+			case InterpolationMode::Linear:
+				return p0 + ( p3 - p0 ) * t;
+			default:
+				break;
+		}
+
+		const Point p1 = p0 + k0.right_tangent;
+		const Point p2 = p3 + k1.left_tangent;
+
+		return Utils::bezier_interp( p0, p1, p2, p3, t );
+	}
+
+	CURVE_X_INLINE Point Curve::evaluate_by_distance( float dist ) const
+	{
+		return evaluate_by_percent( dist / _length );
+	}
+
+	CURVE_X_INLINE float Curve::evaluate_by_time( float time ) const
+	{
+		//  Bound evaluation to first & last points
+		const Point& first_point = get_key( 0 ).control;
+		const Point& last_point = get_key( get_keys_count() - 1 ).control;
+		if ( time <= first_point.x ) return first_point.y;
+		if ( time >= last_point.x ) return last_point.y;
+
+		//  Find evaluation points by time
+		int first_key_id, last_key_id;
+		find_evaluation_keys_id_by_time( 
+			&first_key_id, 
+			&last_key_id, 
+			time 
+		);
+
+		//  Get keys in range
+		const CurveKey& k0 = get_key( first_key_id );
+		const CurveKey& k1 = get_key( last_key_id );
+
+		//  Get control points
+		const Point& p0 = k0.control;
+		const Point& p3 = k1.control;
+
+		//  Get tangent points
+		const Point& t1 = k0.right_tangent;
+		const Point& t2 = k1.left_tangent;
+		/*const float m1 = t1.length();
+		const float m2 = t2.length();*/
+
+		//  Compute time difference
+		const float time_diff = p3.x - p0.x;
+		if ( time_diff <= 0.0f ) return p0.y;
+
+		//  Hold the value until the next key
+		if ( k0.interpolation_mode == InterpolationMode::Constant ) 
+			return p0.y;
+
+		//  Compute time ratio from p0 & p3 (from 0.0f to 1.0f)
+		const float t = ( time - p0.x ) / time_diff;
+
+		if ( k0.interpolation_mode == InterpolationMode::Linear )
+			return p0.y + ( p3.y - p0.y ) * t;
+
+		//  Compute tangents Y-positions
+		/*const float y1 = p0.y + atan2f( t1.y / m1, t1.x / m1 ) * time_diff * m1 / 3.0f;
+		const float y2 = p3.y + atan2f( t2.y / m2, t2.x / m2 ) * time_diff * m2 / 3.0f;*/
+		const float y1 = p0.y + t1.y;
+		const float y2 = p3.y + t2.y;
+
+		return Utils::bezier_interp( p0.y, y1, y2, p3.y, t );
+	}
+
+	CURVE_X_INLINE CurveKey& Curve::get_key( int key_id )
+	{
+		return _keys[key_id];
+	}
+
+	CURVE_X_INLINE const CurveKey& Curve::get_key( int key_id ) const
+	{
+		return _keys[key_id];
+	}
+
+	CURVE_X_INLINE void Curve::find_evaluation_keys_id_by_time( 
+		int* first_key_id,
+		int* last_key_id,
+		float time 
+	) const
+	{
+		/*
+		 * Perform a lower bound to find out the two control points
+		 * to evaluate from.
+		 * 
+		 * Code highly inspired on Unreal Engine's code
+		 */
+
+		int first_id = 1;
+		int last_id = get_keys_count() - 1;
+
+		int count = last_id - first_id;
+		while ( count > 0 )
+		{
+			int step = count / 2;
+			int middle_id = first_id + step;
+
+			if ( time >= get_key( middle_id ).control.x )
+			{
+				first_id = middle_id + 1;
+				count -= step + 1;
+			}
+			else
+			{
+				count = step;
+			}
+		}
+
+		*first_key_id = first_id - 1;
+		*last_key_id = first_id;
+	}
+
+	CURVE_X_INLINE void Curve::find_evaluation_keys_id_by_percent(
+		int* first_key_id,
+		int* last_key_id,
+		float& t
+	) const
+	{
+		int key_id = -1;
+
+		if ( t >= 1.0f )
+		{
+			t = 1.0f;
+			
+			key_id = get_keys_count() - 2;
+		}
+		else
+		{
+			t = fmaxf( t, 0.0f ) * get_curves_count();
+			key_id = (int)floorf( t );
+			t -= (float)key_id;
+		}
+
+		*first_key_id = key_id;
+		*last_key_id = key_id + 1;
+	}
+
+	CURVE_X_INLINE int Curve::get_keys_count() const
+	{
+		return (int)_keys.size();
+	}
+
+	CURVE_X_INLINE int Curve::get_curves_count() const
+	{
+		return get_keys_count() - 1;
+	}
+}
\ No newline at end of file
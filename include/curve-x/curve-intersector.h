@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Default distance under which two curves are considered
+	 * intersecting, used to stop the subdivision.
+	 */
+	constexpr float INTERSECTION_TOLERANCE = 1e-4f;
+
+	/*
+	 * Kind of line to intersect curves with.
+	 */
+	enum class LineType
+	{
+		/*
+		 * Infinite in both directions.
+		 */
+		Line,
+		/*
+		 * Starting from the first point, infinite towards the
+		 * second point.
+		 */
+		Ray,
+		/*
+		 * Limited between both points.
+		 */
+		Segment,
+	};
+
+	/*
+	 * An intersection found on a curve.
+	 */
+	struct CurveIntersection
+	{
+		/*
+		 * Percent on the curve (from 0.0f to 1.0f), usable with
+		 * 'Curve::evaluate_by_percent'.
+		 */
+		float t;
+		/*
+		 * Parameter on the other shape: a percent for curves, or
+		 * a ratio along the line direction, 0.0f being its first
+		 * point and 1.0f its second point.
+		 */
+		float other_t;
+		/*
+		 * Global-space location of the intersection.
+		 */
+		Point point;
+		/*
+		 * Whether the intersection bounds a range where both
+		 * curves overlap, instead of being a single crossing.
+		 */
+		bool is_overlap = false;
+	};
+
+	/*
+	 * Helper class finding intersections between curves and other
+	 * shapes, as parameter pairs.
+	 *
+	 * Constant segments have no path and are never intersected.
+	 * Segments are culled by their control points bounding boxes,
+	 * which always contain them.
+	 */
+	class CurveIntersector
+	{
+	public:
+		/*
+		 * Find the intersections between a curve and a line going
+		 * through both given points, and append them to the given
+		 * vector, sorted by the curve percent.
+		 *
+		 * Each segment is solved exactly, as the roots of a cubic
+		 * formed by projecting it on the line normal. Returns the
+		 * number of appended intersections.
+		 */
+		static int intersect_line(
+			const Curve& curve,
+			const Point& start,
+			const Point& end,
+			LineType line_type,
+			std::vector<CurveIntersection>* intersections
+		);
+
+		/*
+		 * Find the intersections between two curves and append
+		 * them to the given vector, sorted by the first curve
+		 * percent.
+		 *
+		 * Overlapping pairs of segments are found by sweeping
+		 * their bounding boxes along the X-axis, then subdivided
+		 * until their boxes are smaller than the tolerance, and
+		 * refined with Newton's method. Returns the number of
+		 * appended intersections.
+		 *
+		 * Where the curves overlap, such as a curve intersected
+		 * with a copy of itself, only both ends of each overlapping
+		 * range are appended, flagged with 'is_overlap', within the
+		 * tolerance. Overlaps continuing across keys are merged
+		 * into a single range.
+		 */
+		static int intersect_curves(
+			const Curve& curve_a,
+			const Curve& curve_b,
+			std::vector<CurveIntersection>* intersections,
+			float tolerance = INTERSECTION_TOLERANCE
+		);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "compiled-curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Instruction sets the kernels are implemented with, from the
+	 * slowest to the fastest.
+	 */
+	enum class SimdLevel
+	{
+		/*
+		 * Portable reference implementation.
+		 */
+		Scalar,
+		/*
+		 * 4 lanes, using SSE4.2.
+		 */
+		SSE42,
+		/*
+		 * 8 lanes, using AVX2 gathers.
+		 */
+		AVX2,
+		/*
+		 * 16 lanes, using AVX-512F gathers.
+		 */
+		AVX512,
+	};
+
+	/*
+	 * Batch evaluation kernels over compiled curves, selecting at
+	 * runtime the fastest implementation supported by the CPU.
+	 *
+	 * The CPU is detected once, on first use, with 'cpuid'. All
+	 * implementations are built into the library with per-function
+	 * target attributes, so that a single binary runs on any x86
+	 * CPU. Other compilers and architectures only use the scalar
+	 * implementation.
+	 *
+	 * Results match the scalar implementation up to rounding, such
+	 * as lengths being summed in a different order.
+	 *
+	 * Only compiled curves are vectorized: their segments are
+	 * stored as polynomial coefficients at a fixed stride, which the
+	 * kernels gather across lanes. The batch paths of 'Curve' stay
+	 * scalar, since they would need to compile the curve on every
+	 * call, and since its length measures linear segments exactly
+	 * and gives no length to constant ones. Compile a curve once to
+	 * evaluate it in batches with the kernels.
+	 */
+	class CurveKernels
+	{
+	public:
+		/*
+		 * Evaluate the Y-axis values corresponding to an array of
+		 * times, same as 'CompiledCurve::evaluate_by_time'. Both
+		 * arrays must hold 'count' elements.
+		 */
+		static void evaluate_by_time(
+			const CompiledCurve& curve,
+			const float* times,
+			float* values,
+			int count
+		);
+		/*
+		 * Compute the length of the curve, sampling segments with
+		 * the same density as 'Curve::compute_length'.
+		 */
+		static float compute_length(
+			const CompiledCurve& curve,
+			float steps = ITERATIONS_STEPS
+		);
+		/*
+		 * Evaluate 'count' points at evenly spaced percents, from
+		 * the start to the end of the curve, into the given array.
+		 */
+		static void tessellate(
+			const CompiledCurve& curve,
+			int count,
+			Point* points
+		);
+
+		/*
+		 * Returns the fastest level supported by the CPU.
+		 */
+		static SimdLevel detect_simd_level();
+		/*
+		 * Returns the level used by the kernels.
+		 */
+		static SimdLevel get_simd_level();
+		/*
+		 * Force the level used by the kernels, such as to compare
+		 * implementations in tests and benchmarks.
+		 *
+		 * Returns false, leaving the level unchanged, if the level
+		 * is not supported by the CPU.
+		 */
+		static bool set_simd_level( SimdLevel level );
+		/*
+		 * Returns the name of the given level.
+		 */
+		static const char* get_simd_level_name( SimdLevel level );
+	};
+}
\ No newline at end of file
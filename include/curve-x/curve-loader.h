@@ -0,0 +1,123 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "curve.h"
+#include "curve-serializer.h"
+
+namespace curve_x
+{
+	/*
+	 * Outcome of loading a curve file.
+	 */
+	struct CurveLoadResult
+	{
+		std::string path;
+		Curve curve;
+
+		/*
+		 * Whenever the file was read and parsed successfully.
+		 * Otherwise, the reason is stored in 'error', empty files
+		 * being reported as errors.
+		 */
+		bool is_loaded = false;
+		std::string error;
+
+		/*
+		 * Durations, in milliseconds, of reading the file and of
+		 * parsing its data.
+		 */
+		float read_time = 0.0f;
+		float parse_time = 0.0f;
+	};
+
+	/*
+	 * Helper class loading curve files asynchronously on a pool
+	 * of worker threads.
+	 *
+	 * Loading returns futures immediately, letting the caller do
+	 * other work in the meantime. Errors don't throw: they are
+	 * reported inside the results.
+	 *
+	 * Curves are allocated from the default memory resource, as
+	 * arenas are not thread-safe.
+	 */
+	class CurveLoader
+	{
+	public:
+		/*
+		 * Start the given number of worker threads, defaulting to
+		 * the number of hardware threads when 0.
+		 */
+		CurveLoader( int threads_count = 0 );
+		/*
+		 * Finish the pending loads, then stop the worker threads.
+		 */
+		~CurveLoader();
+
+		CurveLoader( const CurveLoader& ) = delete;
+		CurveLoader& operator=( const CurveLoader& ) = delete;
+
+		/*
+		 * Queue the loading of the given file.
+		 */
+		std::future<CurveLoadResult> load( const std::string& path );
+		/*
+		 * Queue the loading of the given files, returning their
+		 * futures in the same order.
+		 */
+		std::vector<std::future<CurveLoadResult>> load(
+			const std::vector<std::string>& paths
+		);
+
+		/*
+		 * Block until all queued loads are finished.
+		 */
+		void wait();
+
+		/*
+		 * Returns the number of loads queued or in progress.
+		 */
+		int get_pending_count() const;
+		/*
+		 * Returns the number of worker threads.
+		 */
+		int get_threads_count() const;
+
+	private:
+		struct LoadTask
+		{
+			std::string path;
+			std::promise<CurveLoadResult> promise;
+		};
+
+		/*
+		 * Process queued tasks until the loader is destroyed.
+		 */
+		void _run_worker();
+		/*
+		 * Read and parse the given file.
+		 */
+		CurveLoadResult _load_file(
+			const std::string& path,
+			CurveSerializer* serializer
+		) const;
+
+	private:
+		std::vector<std::thread> _threads;
+
+		std::deque<LoadTask> _tasks;
+		int _pending_count = 0;
+		bool _is_stopping = false;
+
+		mutable std::mutex _mutex;
+		std::condition_variable _task_condition;
+		std::condition_variable _idle_condition;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Current version of the binary patch format.
+	 *
+	 * Versions history:
+	 * 1: Initial version
+	 */
+	constexpr uint8_t PATCH_FORMAT_VERSION = 1;
+	/*
+	 * Size in bytes of the header starting each patch.
+	 */
+	constexpr size_t PATCH_HEADER_SIZE = 12;
+
+	/*
+	 * Operations of a patch, each mirroring a mutator of 'Curve'.
+	 */
+	enum class PatchOperation : uint8_t
+	{
+		SetPoint = 1,
+		SetTangentPoint = 2,
+		InsertKey = 3,
+		RemoveKey = 4,
+		SetTangentMode = 5,
+		SetInterpolationMode = 6,
+	};
+
+	/*
+	 * Compact binary description of key-level edits, intended to
+	 * send live edits of a curve, such as tangent drags from an
+	 * editor, instead of the whole serialized curve.
+	 *
+	 * A patch is made of a header of 'PATCH_HEADER_SIZE' bytes:
+	 * - the magic 'CXP' followed by the format version (4 bytes)
+	 * - the size of the operations, in bytes (4 bytes)
+	 * - the number of operations (4 bytes)
+	 *
+	 * Then, each operation is its identifier (1 byte) followed by
+	 * the arguments of its mutator: indices are 4-byte integers,
+	 * points are two 4-byte floats and modes are single bytes. All
+	 * numbers are little-endian.
+	 */
+	class CurvePatch
+	{
+	public:
+		CurvePatch();
+
+		/*
+		 * Append operations, see the mutators of 'Curve'.
+		 */
+		void set_point( int point_id, const Point& point );
+		void set_tangent_point(
+			int point_id,
+			const Point& point,
+			PointSpace point_space = PointSpace::Local
+		);
+		void insert_key( int key_id, const CurveKey& key );
+		void remove_key( int key_id );
+		void set_tangent_mode(
+			int key_id,
+			TangentMode mode,
+			bool should_apply_constraint = true
+		);
+		void set_interpolation_mode( int key_id, InterpolationMode mode );
+
+		/*
+		 * Remove all operations.
+		 */
+		void clear();
+
+		/*
+		 * Returns the data of the patch, header included.
+		 */
+		const std::vector<uint8_t>& get_data() const;
+		/*
+		 * Returns the number of operations.
+		 */
+		int get_operations_count() const;
+
+		/*
+		 * Apply this patch to the given curve.
+		 */
+		void apply( Curve* curve ) const;
+		/*
+		 * Apply the given patch data to the given curve, calling
+		 * its mutators so that only the edited segments are marked
+		 * as dirty.
+		 *
+		 * The whole patch is checked before being applied: if the
+		 * data is malformed or an index is out of range, an
+		 * exception is thrown and the curve is left unchanged.
+		 *
+		 * Returns the number of applied operations.
+		 */
+		static int apply( Curve* curve, const uint8_t* data, size_t size );
+
+		/*
+		 * Returns the total size of the patch starting with the
+		 * given header, of 'PATCH_HEADER_SIZE' bytes, in order to
+		 * read patches from a stream.
+		 *
+		 * An exception is thrown if the header is malformed.
+		 */
+		static size_t get_patch_size( const uint8_t* header );
+
+	private:
+		/*
+		 * Append the operation identifier.
+		 */
+		void _begin_operation( PatchOperation operation );
+		/*
+		 * Update the header with the appended operation.
+		 */
+		void _end_operation();
+
+		void _write_int( int32_t value );
+		void _write_float( float value );
+		void _write_point( const Point& point );
+		void _write_byte( uint8_t value );
+
+	private:
+		std::vector<uint8_t> _data;
+		int _operations_count = 0;
+	};
+}
\ No newline at end of file
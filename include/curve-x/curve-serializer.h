@@ -1,8 +1,11 @@
 #pragma once
 
+#include <functional>
+#include <istream>
 #include <string>
 
 #include "curve.h"
+#include "multi-curve.h"
 
 namespace curve_x
 {
@@ -11,14 +14,20 @@ namespace curve_x
 	 * When unserializing, this is used to compare the version of 
 	 * the data, allowing conversions from older to newer versions.
 	 * 
-	 * For now, since its the very first version, this is intended 
-	 * for forward compatibility.
+	 * Versions history:
+	 * 1: Initial version
+	 * 2: Added the interpolation mode of keys, and of multi-channel keys
 	 */
-	const int         FORMAT_VERSION = 1;
+	const int         FORMAT_VERSION = 2;
 	/*
 	 * Conventional file extension to use for curve files.
 	 */
 	const std::string FORMAT_EXTENSION = "cvx";
+	/*
+	 * Number of characters read at once when un-serializing from
+	 * a stream.
+	 */
+	constexpr size_t UNSERIALIZE_CHUNK_SIZE = 64 * 1024;
 
 	/*
 	 * Helper class aiming to serialize and unserialize curves data,
@@ -41,10 +50,82 @@ namespace curve_x
 		 * 
 		 * The given string is assumed to be in the correct format.
 		 * Exceptions can be thrown otherwise.
+		 * 
+		 * Keys of the curve are allocated from the given memory 
+		 * resource, which must outlive the curve.
+		 */
+		Curve unserialize( 
+			const std::string& data,
+			std::pmr::memory_resource* resource 
+				= std::pmr::get_default_resource()
+		);
+
+		/*
+		 * Un-serialize the data read from the given stream into a
+		 * curve object.
+		 * 
+		 * The stream is consumed in chunks of 'UNSERIALIZE_CHUNK_SIZE'
+		 * characters and keys are parsed as soon as their line is
+		 * complete, so the memory used besides the curve does not
+		 * depend on the size of the data.
+		 * 
+		 * The data is assumed to be in the correct format.
+		 * Exceptions can be thrown otherwise.
+		 */
+		Curve unserialize( 
+			std::istream& stream,
+			std::pmr::memory_resource* resource 
+				= std::pmr::get_default_resource()
+		);
+		/*
+		 * Un-serialize the data read from the given stream, calling
+		 * the given callback for each parsed key, in order, instead
+		 * of building a curve.
+		 * 
+		 * Returns the number of parsed keys.
+		 */
+		int unserialize( 
+			std::istream& stream,
+			const std::function<void( const CurveKey& key )>& callback
+		);
+
+		/*
+		 * Serializes the given multi-channel curve into a string.
+		 * 
+		 * The format extends the curve format: the version line is
+		 * followed by a 'channels:<count>' line, and keys are 
+		 * written as 'x=<time>,<tangent mode>,<interpolation mode>'
+		 * (the latter since version 2) followed by a group 
+		 * per channel, separated by '|', made of the value 
+		 * 'y=<value>' and of both tangents.
+		 */
+		std::string serialize( const MultiCurve& curve );
+
+		/*
+		 * Un-serialize the given string data into a multi-channel 
+		 * curve object.
+		 * 
+		 * The given string is assumed to be in the correct format.
+		 * Exceptions can be thrown otherwise.
 		 */
-		Curve unserialize( const std::string& data );
+		MultiCurve unserialize_multi( const std::string& data );
 
 	private:
+		/*
+		 * Parse a line of the curve format, from the given start
+		 * character to the given end character, excluded.
+		 * 
+		 * The first line sets the format version, which is then 
+		 * used to parse the following lines. Returns whenever a key
+		 * was parsed into the given key.
+		 */
+		bool _parse_line( 
+			const char* begin, 
+			const char* end, 
+			int* version, 
+			CurveKey* key 
+		);
+
 		/*
 		 * Converts a string into the integer it represents.
 		 */
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Default maximum distance allowed between a stroke and the
+	 * exact outline of the curve.
+	 */
+	constexpr float STROKE_TOLERANCE = 0.01f;
+	/*
+	 * Default maximum ratio between the length of a miter join
+	 * and the half-width of the stroke.
+	 */
+	constexpr float STROKE_MITER_LIMIT = 4.0f;
+
+	/*
+	 * Shapes of the stroke at the corners of the curve.
+	 */
+	enum class StrokeJoin
+	{
+		/*
+		 * Extend the outer edges until they meet, falling back to
+		 * a bevel beyond the miter limit.
+		 */
+		Miter,
+		/*
+		 * Round the outer edges with an arc.
+		 */
+		Round,
+	};
+
+	/*
+	 * Helper class tessellating the outline of thick curves into
+	 * triangle strips, for rendering.
+	 *
+	 * The curve is flattened by recursively splitting its segments
+	 * until they are within the tolerance, and until their
+	 * direction turns by less than the angle keeping the edges of
+	 * the stroke within the tolerance. Straight parts thus use a
+	 * few vertices while sharp bends use more of them. Constant
+	 * segments are drawn as steps, holding their value until the
+	 * next key.
+	 *
+	 * The strip alternates between the left and the right edges
+	 * of the stroke, starting from the first key. Width and
+	 * tolerance are in curve units.
+	 *
+	 * Strokes are cached per curve, along with its revision, so
+	 * that a curve is only tessellated again once modified. The
+	 * cache is keyed by the address of the curves: use 'forget'
+	 * to release the stroke of a destroyed curve.
+	 */
+	class CurveStroker
+	{
+	public:
+		CurveStroker(
+			float width = 1.0f,
+			StrokeJoin join = StrokeJoin::Miter,
+			float tolerance = STROKE_TOLERANCE
+		);
+
+		/*
+		 * Tessellate the stroke of the given curve into the given
+		 * array of vertices, forming a triangle strip.
+		 *
+		 * Returns the number of vertices of the stroke. They are
+		 * only written if the array capacity is large enough, so
+		 * that the array can be grown before calling it again.
+		 */
+		int stroke( const Curve& curve, Point* vertices, int capacity );
+		/*
+		 * Tessellate the stroke of the given curve, returning the
+		 * cached vertices without copying them.
+		 *
+		 * The reference is valid until the next call modifying
+		 * the cache.
+		 */
+		const std::vector<Point>& stroke( const Curve& curve );
+
+		/*
+		 * Release the cached stroke of the given curve.
+		 */
+		void forget( const Curve& curve );
+		/*
+		 * Release all cached strokes.
+		 */
+		void clear_cache();
+		/*
+		 * Returns the number of cached strokes.
+		 */
+		int get_cached_strokes_count() const;
+
+		/*
+		 * Setters of the stroke parameters, releasing all cached
+		 * strokes when changed.
+		 */
+		void set_width( float width );
+		void set_join( StrokeJoin join );
+		void set_miter_limit( float miter_limit );
+		void set_tolerance( float tolerance );
+
+		float get_width() const;
+		StrokeJoin get_join() const;
+		float get_miter_limit() const;
+		float get_tolerance() const;
+
+	private:
+		/*
+		 * Cached stroke of a curve.
+		 */
+		struct CachedStroke
+		{
+			uint64_t revision = 0;
+			std::vector<Point> vertices;
+		};
+
+		/*
+		 * Update the parameters derived from the width and the
+		 * tolerance.
+		 */
+		void _update_max_angle();
+
+		/*
+		 * Fill the polyline with the flattened curve.
+		 */
+		void _flatten( const Curve& curve );
+		/*
+		 * Append the flattened Bézier segment of the given points,
+		 * excluding its first point.
+		 */
+		void _flatten_segment(
+			const Point& p0, const Point& p1,
+			const Point& p2, const Point& p3,
+			int depth
+		);
+		/*
+		 * Append the given point to the polyline, unless it is at
+		 * the same location as the last one.
+		 */
+		void _add_point( const Point& point );
+
+		/*
+		 * Fill the given vertices with the stroke of the polyline.
+		 */
+		void _tessellate( std::vector<Point>* vertices ) const;
+		/*
+		 * Append the vertices of the join at the given polyline
+		 * point, between the given incoming & outgoing directions.
+		 */
+		void _add_join(
+			const Point& point,
+			const Point& in_direction,
+			const Point& out_direction,
+			std::vector<Point>* vertices
+		) const;
+
+	private:
+		float _width;
+		StrokeJoin _join;
+		float _miter_limit = STROKE_MITER_LIMIT;
+		float _tolerance;
+
+		/*
+		 * Maximum angle, in radians, a direction can turn between
+		 * two vertices while keeping the edges within tolerance.
+		 */
+		float _max_angle = 0.0f;
+
+		std::unordered_map<const Curve*, CachedStroke> _strokes;
+
+		/*
+		 * Flattened curve being tessellated.
+		 */
+		std::vector<Point> _polyline;
+	};
+}
\ No newline at end of file
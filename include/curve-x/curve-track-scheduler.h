@@ -0,0 +1,225 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "compiled-curve.h"
+
+namespace curve_x
+{
+	/*
+	 * Minimum number of tracks given to each thread when advancing
+	 * tracks across threads, below which threads cost more than
+	 * they save.
+	 */
+	constexpr int TRACKS_PER_THREAD_MIN = 2048;
+
+	/*
+	 * Behavior of a track once its time gets out of its curve.
+	 */
+	enum class TrackWrapMode : uint8_t
+	{
+		/*
+		 * Hold the value of the last key, the track is then
+		 * finished.
+		 */
+		Clamp,
+		/*
+		 * Restart from the first key.
+		 */
+		Loop,
+		/*
+		 * Play back and forth between the first and last keys.
+		 */
+		PingPong,
+	};
+
+	/*
+	 * Container playing a large number of curves at once, each
+	 * in a track with its own time, speed and wrap mode.
+	 *
+	 * Tracks are stored as separate arrays of each property and
+	 * sorted by curve before advancing, so that all the tracks of
+	 * a curve are evaluated one after the other while its segments
+	 * are in cache.
+	 *
+	 * Tracks are identified by indices, which are reused once
+	 * removed. Evaluated values are written in caller-provided
+	 * arrays, at the index of their track.
+	 *
+	 * Curves are not owned and must outlive their tracks. They are
+	 * compiled curves only, being immutable and thus safe to share
+	 * with the worker threads, whereas a 'Curve' could be edited
+	 * during a tick. Their segments are also flat and cache-line
+	 * aligned, which is what sorting tracks by curve relies on.
+	 */
+	class CurveTrackScheduler
+	{
+	public:
+		CurveTrackScheduler();
+		/*
+		 * Stop the worker threads.
+		 */
+		~CurveTrackScheduler();
+
+		CurveTrackScheduler( const CurveTrackScheduler& ) = delete;
+		CurveTrackScheduler& operator=( const CurveTrackScheduler& ) = delete;
+
+		/*
+		 * Add a track playing the given curve and returns its
+		 * index.
+		 *
+		 * The time is relative to the first key of the curve, a
+		 * negative time delaying the playback. The speed scales
+		 * the time advanced by 'advance'.
+		 *
+		 * Negative speeds play the curve backwards. Once started,
+		 * looping and ping-pong tracks wrap below the first key
+		 * too, while delayed tracks never start.
+		 */
+		int add_track(
+			const CompiledCurve* curve,
+			float time = 0.0f,
+			float speed = 1.0f,
+			TrackWrapMode wrap_mode = TrackWrapMode::Clamp
+		);
+		/*
+		 * Remove the track at given index.
+		 * The index must refer to a valid track.
+		 */
+		void remove_track( int track_id );
+		/*
+		 * Remove all tracks.
+		 */
+		void clear();
+
+		/*
+		 * Advance the time of all tracks by the given duration,
+		 * scaled by their speed, and write their evaluated values
+		 * into the given array, of at least 'get_tracks_capacity'
+		 * elements. Removed tracks are not written.
+		 *
+		 * Tracks are split across the given number of threads,
+		 * keeping at least 'TRACKS_PER_THREAD_MIN' tracks per
+		 * thread. The calling thread takes a share of the tracks,
+		 * the others go to worker threads, which are started on 
+		 * first use and reused by the next calls.
+		 */
+		void advance( float delta_time, float* values, int threads_count = 1 );
+		/*
+		 * Write the values of all tracks, at their current time,
+		 * into the given array, same as 'advance'.
+		 */
+		void evaluate( float* values, int threads_count = 1 );
+
+		/*
+		 * Set the time of the given track.
+		 * The index must refer to a valid track.
+		 */
+		void set_track_time( int track_id, float time );
+		/*
+		 * Returns the time of the given track, relative to the
+		 * first key of its curve.
+		 * The index must refer to a valid track.
+		 */
+		float get_track_time( int track_id ) const;
+		/*
+		 * Set the speed of the given track.
+		 * The index must refer to a valid track.
+		 */
+		void set_track_speed( int track_id, float speed );
+		/*
+		 * Returns whenever the given track, in 'Clamp' mode, has
+		 * reached the end of its curve. Other modes never finish.
+		 * The index must refer to a valid track.
+		 */
+		bool is_track_finished( int track_id ) const;
+		/*
+		 * Returns whenever the given index refers to a track.
+		 */
+		bool is_valid_track( int track_id ) const;
+
+		/*
+		 * Returns the number of tracks.
+		 */
+		int get_tracks_count() const;
+		/*
+		 * Returns the number of track indices in use, removed
+		 * tracks included, which is the minimum size of the values
+		 * arrays.
+		 */
+		int get_tracks_capacity() const;
+
+	private:
+		/*
+		 * Sort tracks by curve, if tracks were added or removed.
+		 */
+		void _sort_tracks();
+		/*
+		 * Advance and evaluate the tracks of the given range of
+		 * slots.
+		 */
+		void _advance_range(
+			int first_slot,
+			int last_slot,
+			float delta_time,
+			float* values
+		);
+		/*
+		 * Split slots across threads, calling '_advance_range'.
+		 */
+		void _advance_slots( float delta_time, float* values, int threads_count );
+		/*
+		 * Loop of the worker thread of the given index, advancing
+		 * its range of slots at each tick.
+		 */
+		void _run_worker( int worker_id );
+
+	private:
+		/*
+		 * Tracks properties, in slots sorted by curve.
+		 */
+		std::vector<const CompiledCurve*> _curves;
+		std::vector<float> _times;
+		std::vector<float> _speeds;
+		std::vector<TrackWrapMode> _wrap_modes;
+		std::vector<int> _track_ids;
+
+		/*
+		 * Slot of each track index, or -1 for removed tracks.
+		 */
+		std::vector<int> _slots;
+		/*
+		 * Removed track indices, to reuse.
+		 */
+		std::vector<int> _free_track_ids;
+
+		bool _is_sorted = true;
+
+		/*
+		 * Worker threads, each advancing a range of slots per
+		 * tick, and their synchronization.
+		 */
+		std::vector<std::thread> _workers;
+		std::mutex _workers_mutex;
+		std::condition_variable _tick_condition;
+		std::condition_variable _done_condition;
+		bool _is_stopping = false;
+
+		/*
+		 * Current tick, shared with the workers.
+		 */
+		uint64_t _tick_id = 0;
+		int _tick_threads_count = 0;
+		int _tick_tracks_per_thread = 0;
+		float _tick_delta_time = 0.0f;
+		float* _tick_values = nullptr;
+		/*
+		 * Number of workers still advancing the current tick.
+		 */
+		int _pending_workers_count = 0;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
 #include "point.h"
@@ -7,6 +12,8 @@
 
 namespace curve_x
 {
+	class CompiledCurve;
+
 	/*
 	 * The extrems coordinates of a curve, these bounds can be
 	 * represented in a rectangle.
@@ -17,6 +24,77 @@ namespace curve_x
 		float min_y, max_y;
 	};
 
+	/*
+	 * Variation of the value of a curve, or of a segment, over 
+	 * time.
+	 */
+	enum class Monotonicity
+	{
+		/*
+		 * The value never changes.
+		 */
+		Constant,
+		/*
+		 * The value never decreases.
+		 */
+		Increasing,
+		/*
+		 * The value never increases.
+		 */
+		Decreasing,
+		/*
+		 * The value both increases and decreases, and can't be 
+		 * inverted.
+		 */
+		None,
+	};
+
+	/*
+	 * Data computed from a curve segment and cached until the 
+	 * segment is modified.
+	 */
+	struct CurveSegmentCache
+	{
+		/*
+		 * Exact bounds of the segment.
+		 */
+		CurveExtrems bounds { INFINITY, -INFINITY, INFINITY, -INFINITY };
+		/*
+		 * Area under the segment, evaluated by time.
+		 */
+		float integral = 0.0f;
+		/*
+		 * Variation of the segment, evaluated by time.
+		 */
+		Monotonicity monotonicity = Monotonicity::Constant;
+
+		/*
+		 * Boolean stating whenever the data need to be updated.
+		 */
+		bool is_dirty = true;
+	};
+
+	/*
+	 * Report of a curve simplification, see 'Curve::simplify'.
+	 */
+	struct CurveSimplification
+	{
+		/*
+		 * Number of keys removed from the curve.
+		 */
+		int removed_keys_count = 0;
+		/*
+		 * Maximum difference on the Y-axis, evaluated by time, 
+		 * between the original and the simplified curve.
+		 */
+		float time_error = 0.0f;
+		/*
+		 * Maximum distance between the original and the 
+		 * simplified curve.
+		 */
+		float geometry_error = 0.0f;
+	};
+
 	/*
 	 * Default precision value for iteration steps.
 	 * Used for length and nearest point distance calculations.
@@ -52,7 +130,25 @@ namespace curve_x
 	{
 	public:
 		Curve();
-		Curve( const std::vector<CurveKey>& keys );
+		/*
+		 * Construct an empty curve whose keys are allocated from 
+		 * the given memory resource.
+		 * 
+		 * The resource must outlive the curve. Copies of the curve
+		 * are allocated from the default memory resource.
+		 */
+		explicit Curve( std::pmr::memory_resource* resource );
+		Curve( 
+			const std::vector<CurveKey>& keys,
+			std::pmr::memory_resource* resource 
+				= std::pmr::get_default_resource()
+		);
+		/*
+		 * Construct a curve by taking ownership of the given keys,
+		 * without copying them. The curve uses the memory resource
+		 * of the vector.
+		 */
+		Curve( std::pmr::vector<CurveKey>&& keys );
 
 		/*
 		 * Evaluate a curve point at given percent, in range from 
@@ -76,6 +172,124 @@ namespace curve_x
 		 */
 		float evaluate_by_time( float time ) const;
 
+		/*
+		 * Evaluate the first derivative of the curve, relative to 
+		 * the percent, at given percent.
+		 */
+		Point evaluate_derivative_by_percent( float t ) const;
+		/*
+		 * Evaluate the second derivative of the curve, relative to
+		 * the percent, at given percent.
+		 */
+		Point evaluate_second_derivative_by_percent( float t ) const;
+		/*
+		 * Evaluate the signed curvature of the curve at given 
+		 * percent. Positive values turn counter-clockwise.
+		 */
+		float evaluate_curvature_by_percent( float t ) const;
+		/*
+		 * Evaluate both the curve point and its first derivative, 
+		 * relative to the percent, at given percent. 
+		 * 
+		 * This is faster than evaluating them separately.
+		 */
+		void evaluate_with_derivative_by_percent( 
+			float t, 
+			Point* point, 
+			Point* derivative 
+		) const;
+
+		/*
+		 * Evaluate the first derivative of the curve, relative to 
+		 * the distance, at given distance.
+		 * 
+		 * Same as 'evaluate_by_distance', it relies on the 
+		 * previously computed length.
+		 */
+		Point evaluate_derivative_by_distance( float dist ) const;
+		/*
+		 * Evaluate the second derivative of the curve, relative to
+		 * the distance, at given distance.
+		 */
+		Point evaluate_second_derivative_by_distance( float dist ) const;
+		/*
+		 * Evaluate the signed curvature of the curve at given 
+		 * distance.
+		 */
+		float evaluate_curvature_by_distance( float dist ) const;
+
+		/*
+		 * Evaluate the slope of the curve, i.e. the derivative of 
+		 * the Y-axis relative to the time, at given time.
+		 * 
+		 * The slope is null outside of the keys time range.
+		 */
+		float evaluate_derivative_by_time( float time ) const;
+		/*
+		 * Evaluate the second derivative of the Y-axis relative to
+		 * the time, at given time.
+		 */
+		float evaluate_second_derivative_by_time( float time ) const;
+		/*
+		 * Evaluate the curvature of the graph of the curve at 
+		 * given time.
+		 */
+		float evaluate_curvature_by_time( float time ) const;
+		/*
+		 * Evaluate both the Y-axis value and the slope at given 
+		 * time.
+		 * 
+		 * This is faster than evaluating them separately.
+		 */
+		void evaluate_with_derivative_by_time( 
+			float time, 
+			float* value, 
+			float* derivative 
+		) const;
+
+		/*
+		 * Evaluate the Y-axis values corresponding to an array of 
+		 * times. Both arrays must hold 'count' elements.
+		 * 
+		 * This is a scalar loop: for vectorized evaluations, see 
+		 * 'CurveKernels' over the compiled curve.
+		 */
+		void evaluate_by_time( 
+			const float* times, 
+			float* values, 
+			int count 
+		) const;
+		/*
+		 * Evaluate the Y-axis values and slopes corresponding to 
+		 * an array of times. All arrays must hold 'count' elements.
+		 */
+		void evaluate_with_derivative_by_time( 
+			const float* times, 
+			float* values, 
+			float* derivatives,
+			int count 
+		) const;
+		/*
+		 * Distribute 'count' points evenly spaced by arc length 
+		 * along the curve, from its start to its end, and write 
+		 * them inside the given array. 
+		 * 
+		 * Unit tangents are written at the same indexes if a 
+		 * tangents array is given. Both arrays must hold 'count' 
+		 * elements. 
+		 * 
+		 * The curve is sampled once, cubic segments with the same 
+		 * density as 'compute_length', into a table of cumulative 
+		 * lengths. Points are then placed by walking this table, 
+		 * so that it runs in O(count + samples).
+		 */
+		void distribute_by_distance( 
+			int count, 
+			Point* points, 
+			Point* tangents = nullptr,
+			const float steps = ITERATIONS_STEPS
+		) const;
+
 		/*
 		 * Add a key at the end of the vector.
 		 */
@@ -86,15 +300,112 @@ namespace curve_x
 		 * keys count.
 		 */
 		void insert_key( int key_id, const CurveKey& key );
+		/*
+		 * Construct a key in-place at the end of the vector, 
+		 * forwarding the given arguments to its constructor.
+		 */
+		template<typename... Args>
+		CurveKey& emplace_key( Args&&... args )
+		{
+			CurveKey& key = _keys.emplace_back( 
+				std::forward<Args>( args )... );
+
+			_on_key_inserted( get_keys_count() - 1 );
+			return key;
+		}
+		/*
+		 * Insert a range of keys before given index, in one go.
+		 * The index must refer either to a valid key or to the 
+		 * keys count.
+		 */
+		template<typename Iterator>
+		void insert_keys( int key_id, Iterator first, Iterator last )
+		{
+			_keys.insert( _keys.begin() + key_id, first, last );
+
+			mark_dirty();
+		}
+		/*
+		 * Replace all keys by a copy of the given array of keys.
+		 */
+		void assign_keys( const CurveKey* keys, int count );
+		/*
+		 * Insert a key while keeping the keys sorted by time, 
+		 * assuming they already are. 
+		 * 
+		 * The insertion index is found with a binary search and 
+		 * returned. A key is inserted after the keys sharing its 
+		 * time.
+		 */
+		int insert_key_by_time( const CurveKey& key );
+		/*
+		 * Insert a range of keys while keeping the keys sorted by
+		 * time, assuming they already are.
+		 * 
+		 * The given keys do not need to be sorted. Insertion is 
+		 * done in one go: new keys are appended, sorted then 
+		 * merged with the existing keys.
+		 */
+		template<typename Iterator>
+		void insert_keys_by_time( Iterator first, Iterator last )
+		{
+			auto compare = []( const CurveKey& a, const CurveKey& b )
+			{
+				return a.control.x < b.control.x;
+			};
+
+			const size_t count = _keys.size();
+			_keys.insert( _keys.end(), first, last );
+
+			auto middle = _keys.begin() + count;
+			std::stable_sort( middle, _keys.end(), compare );
+			std::inplace_merge( _keys.begin(), middle, _keys.end(), 
+				compare );
+
+			mark_dirty();
+		}
 		/*
 		 * Remove a key at given index. 
 		 * The index must refer to a valid key.
 		 */
 		void remove_key( int key_id );
+		/*
+		 * Remove redundant keys while keeping the curve within the
+		 * given maximum deviation from the original curve.
+		 * 
+		 * Keys are greedily removed, the tangents of both 
+		 * neighbour keys being re-solved by least squares along 
+		 * their directions, except for mirrored ones which are 
+		 * kept as-is. Only keys surrounded by segments of the 
+		 * same interpolation mode are removed.
+		 * 
+		 * The deviation is measured both by geometry and by time, 
+		 * the latter only where keys are sorted by time. Returns 
+		 * the number of removed keys and the achieved errors.
+		 */
+		CurveSimplification simplify( float tolerance );
+
+		/*
+		 * Reserve memory for the given number of keys, avoiding 
+		 * reallocations when adding keys.
+		 */
+		void reserve( int keys_count );
+		/*
+		 * Free the memory reserved for keys which are not used.
+		 */
+		void shrink_to_fit();
+		/*
+		 * Returns the number of keys the curve can hold without 
+		 * reallocating.
+		 */
+		int get_capacity() const;
 
 		/*
 		 * Get a reference to the key at given index.
 		 * The index must refer to a valid key.
+		 * 
+		 * Modifying the key through this reference does not 
+		 * invalidate cached data, see 'mark_key_dirty'.
 		 */
 		CurveKey& get_key( int key_id );
 		/*
@@ -143,6 +454,9 @@ namespace curve_x
 		/*
 		 * Compute the nearest curve distance from an arbitrary 
 		 * global-space point.
+		 * 
+		 * Cubic segments are sampled while linear segments are 
+		 * solved exactly.
 		 */
 		float get_nearest_distance_to(
 			const Point& point,
@@ -177,6 +491,18 @@ namespace curve_x
 		 */
 		TangentMode get_tangent_mode( int key_id ) const;
 
+		/*
+		 * Change the interpolation mode of the segment starting 
+		 * at the given key index.
+		 * The index must refer to a valid key.
+		 */
+		void set_interpolation_mode( int key_id, InterpolationMode mode );
+		/*
+		 * Returns the interpolation mode of given key index.
+		 * The index must refer to a valid key.
+		 */
+		InterpolationMode get_interpolation_mode( int key_id ) const;
+
 		/*
 		 * Returns whenever the curve contains a valid amount of 
 		 * points for further usage.
@@ -212,9 +538,178 @@ namespace curve_x
 		) const;
 		/*
 		 * Returns the coordinates extrems of all points.
+		 * 
+		 * Tangent points are included, which overestimates the 
+		 * bounds of the curve itself, see 'get_bounds'.
 		 */
 		CurveExtrems get_extrems() const;
 
+		/*
+		 * Returns the exact bounds of the curve. 
+		 * If marked as dirty, the modified segments are updated 
+		 * beforehand.
+		 */
+		CurveExtrems get_bounds();
+		/*
+		 * Returns the previously computed exact bounds of the 
+		 * curve. 
+		 * 
+		 * Due to constness, it will NOT update the segments cache 
+		 * if marked as dirty, see 'update_segments_cache'.
+		 */
+		CurveExtrems get_bounds() const;
+		/*
+		 * Returns the previously computed exact bounds of the 
+		 * given segment index.
+		 * The index must refer to a valid segment.
+		 */
+		CurveExtrems get_segment_bounds( int curve_id ) const;
+
+		/*
+		 * Compute the integral of the curve evaluated by time, 
+		 * i.e. the area under the curve, between two times.
+		 * 
+		 * Outside of the keys, the curve is considered constant, 
+		 * same as 'evaluate_by_time'. The curve must have at
+		 * least one key.
+		 * 
+		 * If marked as dirty, the modified segments are updated 
+		 * beforehand. Using cached integrals of the segments, it 
+		 * is done in logarithmic time.
+		 */
+		float integrate( float start_time, float end_time );
+		/*
+		 * Compute the integral of the curve between two times, 
+		 * using the previously computed segments integrals.
+		 * 
+		 * Due to constness, it will NOT update the segments cache 
+		 * if marked as dirty, see 'update_segments_cache'. Returns
+		 * 0.0f if segments have been added or removed since.
+		 */
+		float integrate( float start_time, float end_time ) const;
+
+		/*
+		 * Returns the variation of the curve evaluated by time.
+		 * If marked as dirty, the modified segments are updated 
+		 * beforehand.
+		 */
+		Monotonicity get_monotonicity();
+		/*
+		 * Returns the previously computed variation of the curve.
+		 * 
+		 * Due to constness, it will NOT update the segments cache 
+		 * if marked as dirty, see 'update_segments_cache'.
+		 */
+		Monotonicity get_monotonicity() const;
+		/*
+		 * Returns the previously computed variation of the given
+		 * segment index. Segments with 'Monotonicity::None' are 
+		 * the regions preventing the curve to be inverted.
+		 * The index must refer to a valid segment.
+		 */
+		Monotonicity get_segment_monotonicity( int curve_id ) const;
+
+		/*
+		 * Find the time at which the curve, evaluated by time, 
+		 * reaches the given value. Inverse of 'evaluate_by_time'.
+		 * 
+		 * Only monotonic curves can be inverted. Returns false 
+		 * if the curve is not monotonic, see 'get_monotonicity', 
+		 * or if the value is out of its range. On flat regions,
+		 * the earliest time is given.
+		 * 
+		 * If marked as dirty, the modified segments are updated 
+		 * beforehand. The segment is found by binary search on 
+		 * the keys values, then its cubic is solved.
+		 */
+		bool inverse_evaluate_by_time( float value, float* time );
+		/*
+		 * Find the time at which the curve reaches the given 
+		 * value, see above.
+		 * 
+		 * Due to constness, it will NOT update the segments cache 
+		 * if marked as dirty, see 'update_segments_cache'.
+		 */
+		bool inverse_evaluate_by_time( float value, float* time ) const;
+
+		/*
+		 * Find all times, between the given times, at which the 
+		 * curve evaluated by time crosses the given value, and 
+		 * append them in ascending order to the given vector. 
+		 * 
+		 * A crossing is reported each time the curve goes from 
+		 * below the value to above or equal, and vice versa. 
+		 * Returns the number of appended times.
+		 * 
+		 * If marked as dirty, the modified segments are updated 
+		 * beforehand. Segments out of the value range are skipped
+		 * by their cached bounds.
+		 */
+		int find_crossings_by_time( 
+			float value, 
+			float start_time, 
+			float end_time, 
+			std::vector<float>* times 
+		);
+		/*
+		 * Find all times at which the curve crosses the given 
+		 * value, see above.
+		 * 
+		 * Due to constness, it will NOT update the segments cache 
+		 * if marked as dirty, see 'update_segments_cache'. 
+		 */
+		int find_crossings_by_time( 
+			float value, 
+			float start_time, 
+			float end_time, 
+			std::vector<float>* times 
+		) const;
+		/*
+		 * Find all times, strictly between the given times, at 
+		 * which the curve evaluated by time reaches a local 
+		 * minimum or maximum, and append them in ascending order 
+		 * to the given vector.
+		 * 
+		 * On flat regions, the earliest time is reported. Returns 
+		 * the number of appended times.
+		 * 
+		 * If marked as dirty, the modified segments are updated 
+		 * beforehand.
+		 */
+		int find_local_extrems_by_time( 
+			float start_time, 
+			float end_time, 
+			std::vector<float>* times 
+		);
+		/*
+		 * Find all times at which the curve reaches a local 
+		 * extremum, see above.
+		 * 
+		 * Due to constness, it will NOT update the segments cache 
+		 * if marked as dirty, see 'update_segments_cache'. 
+		 */
+		int find_local_extrems_by_time( 
+			float start_time, 
+			float end_time, 
+			std::vector<float>* times 
+		) const;
+
+		/*
+		 * Fill given variables with the four Bézier points, in 
+		 * global space, of the given segment index.
+		 * The index must refer to a valid segment.
+		 * 
+		 * Linear segments are converted to their equivalent cubic 
+		 * points. Constant segments have all their points at the 
+		 * first control point, since their value is held until 
+		 * the next key.
+		 */
+		void get_segment_points( 
+			int curve_id,
+			Point* p0, Point* p1, 
+			Point* p2, Point* p3 
+		) const;
+
 		/*
 		 * Fill given variables with the first & last key indexes 
 		 * to use for evaluation from given time.
@@ -262,6 +757,9 @@ namespace curve_x
 		/*
 		 * Compute the curve's length, representing the maximum 
 		 * evaluable distance.
+		 * 
+		 * Cubic segments are sampled while linear segments are 
+		 * computed exactly. Constant segments have no length.
 		 */
 		void compute_length( const float steps = ITERATIONS_STEPS );
 
@@ -280,12 +778,133 @@ namespace curve_x
 		 */
 		float get_length() const;
 
+		/*
+		 * Update the cached data of the segments marked as dirty,
+		 * and the data merged from them such as the bounds.
+		 */
+		void update_segments_cache();
+		/*
+		 * Mark the segments around the given key as modified, 
+		 * invalidating their cached data and the length.
+		 * 
+		 * Mutators already take care of it, this is only needed 
+		 * after modifying a key through 'get_key'.
+		 */
+		void mark_key_dirty( int key_id );
+		/*
+		 * Mark all segments as modified, invalidating all cached 
+		 * data and the length.
+		 */
+		void mark_dirty();
+
+		/*
+		 * Produce an immutable and evaluation-only copy of the 
+		 * curve, see 'CompiledCurve'. 
+		 * 
+		 * Requires to include 'curve-x/compiled-curve.h'.
+		 */
+		CompiledCurve compile() const;
+
+		/*
+		 * Returns the memory resource used to allocate the keys.
+		 */
+		std::pmr::memory_resource* get_memory_resource() const;
+		/*
+		 * Returns an identifier of the state of the keys, changing
+		 * each time the curve is marked as dirty, so that data
+		 * derived from the curve can be cached outside of it.
+		 *
+		 * Identifiers are unique among all curves, except between
+		 * a curve and its unmodified copies. An identifier is only
+		 * generated on the first call after a modification, hence
+		 * concurrent calls on a modified curve must be 
+		 * synchronized.
+		 */
+		uint64_t get_revision() const;
+
 	public:
 		/*
 		 * Boolean stating whenever the length need to be updated.
 		 */
 		bool is_length_dirty = true;
 
+	private:
+		/*
+		 * Evaluate the curve point and its derivatives relative 
+		 * to the percent at given percent. 
+		 * 
+		 * Given array is filled from the point to the derivative 
+		 * of given order (up to 2).
+		 */
+		void _evaluate_by_percent( float t, Point* points, int order ) const;
+		/*
+		 * Evaluate the Y-axis value and its derivatives relative 
+		 * to the time at given time. 
+		 * 
+		 * Given array is filled from the value to the derivative 
+		 * of given order (up to 2).
+		 */
+		void _evaluate_by_time( float time, float* values, int order ) const;
+
+		/*
+		 * Keep the segments cache aligned with the keys after 
+		 * inserting a key at given index.
+		 */
+		void _on_key_inserted( int key_id );
+		/*
+		 * Keep the segments cache aligned with the keys after 
+		 * removing the key at given index.
+		 */
+		void _on_key_removed( int key_id );
+		/*
+		 * Compute the cached data of the given segment index.
+		 */
+		void _compute_segment_cache( 
+			int curve_id, 
+			CurveSegmentCache* cache 
+		) const;
+		/*
+		 * Find the ratio 't' at which the given segment index 
+		 * reaches the given value, between the given ratios 
+		 * (from 0.0f to 1.0f). 
+		 * 
+		 * The segment must be monotonic between these ratios 
+		 * and the value must be reached in-between.
+		 */
+		float _solve_segment_by_value( 
+			int curve_id, 
+			float value, 
+			float min_t, 
+			float max_t 
+		) const;
+		/*
+		 * Fill given array with the ratios (from 0.0f to 1.0f), 
+		 * in ascending order, at which the given segment index 
+		 * evaluated by time changes of direction.
+		 * 
+		 * Only segments cached as non-monotonic have some. 
+		 * Returns the number of ratios, from 0 to 2.
+		 */
+		int _find_segment_turning_points( int curve_id, float* ts ) const;
+		/*
+		 * Compute the integral of the curve from its first key to
+		 * the given time, using the cached prefix integrals.
+		 */
+		float _integrate_to( float time ) const;
+		/*
+		 * Compute the integral of the given segment index, from 
+		 * its start to the given ratio 't' (from 0.0f to 1.0f).
+		 */
+		float _integrate_segment( int curve_id, float t ) const;
+		/*
+		 * Compute the length of the given segment index, sampling
+		 * cubic segments with the given samples count.
+		 */
+		float _compute_segment_length( 
+			int curve_id, 
+			int samples_count 
+		) const;
+
 	private:
 		/*
 		 * Length of the curve, representing its maximum distance.
@@ -297,6 +916,42 @@ namespace curve_x
 		 * Vector containing the keys.
 		 * The required index is refered as a 'key index'.
 		 */
-		std::vector<CurveKey> _keys;
+		std::pmr::vector<CurveKey> _keys;
+
+		/*
+		 * Cached data of each segment, referred by a 'curve index'.
+		 * It is sized lazily by 'update_segments_cache'.
+		 */
+		std::pmr::vector<CurveSegmentCache> _segments_cache;
+		/*
+		 * Boolean stating whenever some segments need to be 
+		 * updated.
+		 */
+		bool _is_segments_cache_dirty = true;
+
+		/*
+		 * Integral of the curve from its first key to each key, 
+		 * accumulated from the segments integrals.
+		 */
+		std::pmr::vector<float> _prefix_integrals;
+		/*
+		 * Variation of the curve, merged from the segments.
+		 */
+		Monotonicity _monotonicity = Monotonicity::Constant;
+
+		/*
+		 * Exact bounds of the curve, merged from the segments.
+		 */
+		CurveExtrems _bounds { INFINITY, -INFINITY, INFINITY, -INFINITY };
+
+		/*
+		 * Identifier of the state of the keys, see 'get_revision',
+		 * or 0 if not generated since the last modification.
+		 */
+		mutable uint64_t _revision = 0;
 	};
-}
\ No newline at end of file
+}
+
+#ifdef CURVE_X_INLINE_HOT_PATHS
+#include "curve-inline.h"
+#endif
\ No newline at end of file
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * A read-only curve of 'N' keys whose construction and
+	 * evaluation can be done at compile-time.
+	 *
+	 * It is intended for small curves that never change at
+	 * runtime: the keys are stored inside a 'std::array' and the
+	 * search of the keys to evaluate from is unrolled by the
+	 * compiler, so that evaluating a constant curve with a constant
+	 * input can be folded into a constant.
+	 *
+	 * Requires C++17.
+	 */
+	template<size_t N>
+	class FixedCurve
+	{
+		static_assert( N >= 2, "A fixed curve requires at least 2 keys" );
+
+	public:
+		template<
+			typename... Keys,
+			std::enable_if_t<sizeof...( Keys ) == N, int> = 0
+		>
+		constexpr FixedCurve( const Keys&... keys )
+			: _keys { { CurveKey( keys )... } }
+		{}
+		constexpr FixedCurve( const std::array<CurveKey, N>& keys )
+			: _keys( keys )
+		{}
+
+		/*
+		 * Evaluate a curve point at given percent, in range from
+		 * 0.0f to 1.0f.
+		 */
+		constexpr Point evaluate_by_percent( float t ) const
+		{
+			size_t key_id = 0;
+			if ( t >= 1.0f )
+			{
+				t = 1.0f;
+				key_id = N - 2;
+			}
+			else
+			{
+				t = ( t > 0.0f ? t : 0.0f ) * ( N - 1 );
+				key_id = (size_t)t;
+				t -= (float)key_id;
+			}
+
+			const CurveKey& k0 = _keys[key_id];
+			const CurveKey& k1 = _keys[key_id + 1];
+
+			const Point& p0 = k0.control;
+			const Point& p3 = k1.control;
+
+			switch ( k0.interpolation_mode )
+			{
+				case InterpolationMode::Constant:
+					return t < 1.0f ? p0 : p3;
+				case InterpolationMode::Linear:
+					return p0 + ( p3 - p0 ) * t;
+				default:
+					break;
+			}
+
+			const Point p1 = p0 + k0.right_tangent;
+			const Point p2 = p3 + k1.left_tangent;
+
+			return Utils::bezier_interp( p0, p1, p2, p3, t );
+		}
+		/*
+		 * Evaluate the Y-axis value corresponding to the given
+		 * time on the X-axis.
+		 *
+		 * Follows the same rules as 'Curve::evaluate_by_time'.
+		 */
+		constexpr float evaluate_by_time( float time ) const
+		{
+			//  Bound evaluation to first & last points
+			const Point& first_point = _keys[0].control;
+			const Point& last_point = _keys[N - 1].control;
+			if ( time <= first_point.x ) return first_point.y;
+			if ( time >= last_point.x ) return last_point.y;
+
+			const size_t key_id = _find_evaluation_key_id_by_time( time );
+			const CurveKey& k0 = _keys[key_id];
+			const CurveKey& k1 = _keys[key_id + 1];
+
+			const Point& p0 = k0.control;
+			const Point& p3 = k1.control;
+
+			//  Compute time difference
+			const float time_diff = p3.x - p0.x;
+			if ( time_diff <= 0.0f ) return p0.y;
+
+			if ( k0.interpolation_mode == InterpolationMode::Constant )
+				return p0.y;
+
+			//  Compute time ratio from p0 & p3 (from 0.0f to 1.0f)
+			const float t = ( time - p0.x ) / time_diff;
+
+			if ( k0.interpolation_mode == InterpolationMode::Linear )
+				return p0.y + ( p3.y - p0.y ) * t;
+
+			const float y1 = p0.y + k0.right_tangent.y;
+			const float y2 = p3.y + k1.left_tangent.y;
+
+			return Utils::bezier_interp( p0.y, y1, y2, p3.y, t );
+		}
+
+		/*
+		 * Get a const-reference to the key at given index.
+		 * The index must refer to a valid key.
+		 */
+		constexpr const CurveKey& get_key( size_t key_id ) const
+		{
+			return _keys[key_id];
+		}
+		/*
+		 * Get the array containing the keys.
+		 */
+		constexpr const std::array<CurveKey, N>& get_keys() const
+		{
+			return _keys;
+		}
+
+		/*
+		 * Returns the number of keys.
+		 */
+		static constexpr size_t get_keys_count()
+		{
+			return N;
+		}
+		/*
+		 * Returns the number of curves formed by the keys.
+		 */
+		static constexpr size_t get_curves_count()
+		{
+			return N - 1;
+		}
+
+		/*
+		 * Copy the keys into an editable curve.
+		 */
+		Curve to_curve() const
+		{
+			return Curve( std::vector<CurveKey>( _keys.begin(), _keys.end() ) );
+		}
+
+	private:
+		/*
+		 * Returns the index of the first key to evaluate from at
+		 * given time.
+		 *
+		 * The search is done linearly from key 'I' and unrolled at
+		 * compile-time, which is faster than a binary search for
+		 * the small amount of keys this class is intended for.
+		 */
+		template<size_t I = 1>
+		constexpr size_t _find_evaluation_key_id_by_time( float time ) const
+		{
+			if constexpr ( I >= N - 1 )
+			{
+				return N - 2;
+			}
+			else
+			{
+				if ( time < _keys[I].control.x ) return I - 1;
+				return _find_evaluation_key_id_by_time<I + 1>( time );
+			}
+		}
+
+	private:
+		std::array<CurveKey, N> _keys;
+	};
+
+	template<typename... Keys>
+	FixedCurve( const Keys&... ) -> FixedCurve<sizeof...( Keys )>;
+}
\ No newline at end of file
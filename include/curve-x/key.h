@@ -28,9 +28,35 @@ namespace curve_x
 		MAX,
 	};
 
+	/*
+	 * Interpolation mode which defines how a segment is evaluated 
+	 * from its first key to the next one.
+	 */
+	enum class InterpolationMode
+	{
+		/*
+		 * The value of the first key is held until the next key.
+		 */
+		Constant	= 0,
+
+		/*
+		 * Straight line between both control points, tangents 
+		 * are ignored.
+		 */
+		Linear		= 1,
+
+		/*
+		 * Bézier cubic interpolation using the tangents.
+		 */
+		Cubic		= 2,
+
+		MAX,
+	};
+
 	/*
 	 * A key inside a curve consisting of a control point, two
-	 * tangents and the related tangent mode.
+	 * tangents, the related tangent mode and the interpolation 
+	 * mode of the segment starting at this key.
 	 * 
 	 * Tangent points are stored in local-space, forming a weighted 
 	 * direction from the control point.
@@ -38,12 +64,20 @@ namespace curve_x
 	class CurveKey
 	{
 	public:
-		CurveKey( 
+		constexpr CurveKey( 
 			const Point& control, 
 			const Point& left_tangent = { -1.0f, 0.0f },
 			const Point& right_tangent = { 1.0f, 0.0f },
-			TangentMode tangent_mode = TangentMode::Mirrored
-		);
+			TangentMode tangent_mode = TangentMode::Mirrored,
+			InterpolationMode interpolation_mode 
+				= InterpolationMode::Cubic
+		)
+			: control( control ),
+			  left_tangent( left_tangent ),
+			  right_tangent( right_tangent ),
+			  tangent_mode( tangent_mode ),
+			  interpolation_mode( interpolation_mode )
+		{}
 
 		/*
 		 * Set the location of the left tangent (in local space) 
@@ -64,6 +98,7 @@ namespace curve_x
 		Point right_tangent;
 
 		TangentMode tangent_mode;
+		InterpolationMode interpolation_mode;
 
 		//  TODO: Implement the distance on the curve for each key 
 		//float distance = -1.0f;
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * A timed-based curve holding several values, or 'channels',
+	 * per key, such as the components of a color or of a position.
+	 *
+	 * All channels share the same key times, tangent modes and 
+	 * interpolation modes, so that the keys to evaluate from are 
+	 * searched once per evaluation for all channels. Each channel has its own value
+	 * and tangents, which behave like the control point Y-axis and
+	 * the tangents of a 'CurveKey'.
+	 *
+	 * Per-channel data is stored in separate contiguous arrays,
+	 * indexed by 'key_id * channels_count + channel', allowing the
+	 * interpolation of all channels to be vectorized.
+	 */
+	class MultiCurve
+	{
+	public:
+		explicit MultiCurve( int channels_count = 1 );
+		/*
+		 * Construct a multi-channel curve from several curves, one
+		 * per channel.
+		 *
+		 * All curves must have the same key times, tangent modes
+		 * and interpolation modes, an 'std::invalid_argument' is 
+		 * thrown otherwise.
+		 */
+		explicit MultiCurve( const std::vector<Curve>& curves );
+
+		/*
+		 * Evaluate the values of all channels corresponding to the
+		 * given time, and write them inside the given array.
+		 *
+		 * The array must be able to hold a value per channel.
+		 */
+		void evaluate_by_time( float time, float* values ) const;
+
+		/*
+		 * Add a key at the end of the curve.
+		 *
+		 * Given arrays must hold a value or a tangent per channel.
+		 * Tangents are in local space, like in 'CurveKey'.
+		 */
+		void add_key(
+			float time,
+			const float* values,
+			const Point* left_tangents,
+			const Point* right_tangents,
+			TangentMode tangent_mode = TangentMode::Mirrored,
+			InterpolationMode interpolation_mode = InterpolationMode::Cubic
+		);
+		/*
+		 * Add a key at the end of the curve with flat tangents.
+		 *
+		 * The given array must hold a value per channel.
+		 */
+		void add_key(
+			float time,
+			const float* values,
+			TangentMode tangent_mode = TangentMode::Mirrored,
+			InterpolationMode interpolation_mode = InterpolationMode::Cubic
+		);
+		/*
+		 * Remove a key at given index.
+		 * The index must refer to a valid key.
+		 */
+		void remove_key( int key_id );
+
+		/*
+		 * Returns the time of the given key index.
+		 * The index must refer to a valid key.
+		 */
+		float get_key_time( int key_id ) const;
+		/*
+		 * Returns the tangent mode of the given key index.
+		 * The index must refer to a valid key.
+		 */
+		TangentMode get_tangent_mode( int key_id ) const;
+		/*
+		 * Set the interpolation mode of the segment starting at 
+		 * the given key index, for all channels.
+		 * The index must refer to a valid key.
+		 */
+		void set_interpolation_mode( int key_id, InterpolationMode mode );
+		/*
+		 * Returns the interpolation mode of the segment starting 
+		 * at the given key index.
+		 * The index must refer to a valid key.
+		 */
+		InterpolationMode get_interpolation_mode( int key_id ) const;
+
+		/*
+		 * Set the value of a channel at given key index.
+		 * Both indices must be valid.
+		 */
+		void set_value( int key_id, int channel, float value );
+		/*
+		 * Returns the value of a channel at given key index.
+		 * Both indices must be valid.
+		 */
+		float get_value( int key_id, int channel ) const;
+
+		/*
+		 * Set the tangents, in local space, of a channel at given
+		 * key index. Tangent mode constraints are NOT applied.
+		 * Both indices must be valid.
+		 */
+		void set_tangents(
+			int key_id,
+			int channel,
+			const Point& left_tangent,
+			const Point& right_tangent
+		);
+		/*
+		 * Returns the left tangent, in local space, of a channel at
+		 * given key index.
+		 * Both indices must be valid.
+		 */
+		Point get_left_tangent( int key_id, int channel ) const;
+		/*
+		 * Returns the right tangent, in local space, of a channel at
+		 * given key index.
+		 * Both indices must be valid.
+		 */
+		Point get_right_tangent( int key_id, int channel ) const;
+
+		/*
+		 * Copy a single channel into a curve.
+		 * The channel must be valid.
+		 */
+		Curve extract_channel( int channel ) const;
+
+		/*
+		 * Fill given variables with the first & last key indexes
+		 * to use for evaluation from given time.
+		 */
+		void find_evaluation_keys_id_by_time(
+			int* first_key_id,
+			int* last_key_id,
+			float time
+		) const;
+
+		/*
+		 * Returns whenever the curve contains a valid amount of
+		 * keys for evaluation.
+		 */
+		bool is_valid() const;
+
+		/*
+		 * Returns the number of values per key.
+		 */
+		int get_channels_count() const;
+		/*
+		 * Returns the number of keys.
+		 */
+		int get_keys_count() const;
+		/*
+		 * Returns the number of curves formed by the keys.
+		 */
+		int get_curves_count() const;
+
+	private:
+		int _channels_count;
+
+		/*
+		 * Per-key data.
+		 */
+		std::vector<float> _times;
+		std::vector<TangentMode> _tangent_modes;
+		std::vector<InterpolationMode> _interpolation_modes;
+
+		/*
+		 * Per-channel data, indexed by
+		 * 'key_id * channels_count + channel'.
+		 */
+		std::vector<float> _values;
+		std::vector<float> _left_tangents_x;
+		std::vector<float> _left_tangents_y;
+		std::vector<float> _right_tangents_x;
+		std::vector<float> _right_tangents_y;
+	};
+}
\ No newline at end of file
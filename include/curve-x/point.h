@@ -35,9 +35,9 @@ namespace curve_x
 		float x, y;
 
 	public:
-		Point()
+		constexpr Point()
 			: x( 0.0f ), y( 0.0f ) {}
-		Point( float x, float y )
+		constexpr Point( float x, float y )
 			: x( x ), y( y ) {}
 
 #ifdef RAYLIB_H
@@ -46,28 +46,28 @@ namespace curve_x
 		operator Vector2() const { return Vector2 { x, y }; }
 #endif
 
-		Point operator+( const Point& point ) const
+		constexpr Point operator+( const Point& point ) const
 		{
 			return {
 				x + point.x,
 				y + point.y
 			};
 		}
-		Point operator-( const Point& point ) const
+		constexpr Point operator-( const Point& point ) const
 		{
 			return {
 				x - point.x,
 				y - point.y
 			};
 		}
-		Point operator*( float value ) const
+		constexpr Point operator*( float value ) const
 		{
 			return {
 				x * value,
 				y * value
 			};
 		}
-		Point operator/( float value ) const
+		constexpr Point operator/( float value ) const
 		{
 			return {
 				x / value,
@@ -75,7 +75,7 @@ namespace curve_x
 			};
 		}
 
-		Point operator-() const
+		constexpr Point operator-() const
 		{
 			return {
 				-x,
@@ -83,7 +83,7 @@ namespace curve_x
 			};
 		}
 
-		bool operator==( const Point& point ) const
+		constexpr bool operator==( const Point& point ) const
 		{
 			return x == point.x 
 				&& y == point.y;
@@ -102,7 +102,7 @@ namespace curve_x
 		 * Returns a copy of the point whose axes are remapped from 
 		 * range 'in' to range 'out'.
 		 */
-		Point remap( 
+		constexpr Point remap( 
 			float in_min_x, float in_max_x, 
 			float out_min_x, float out_max_x,
 			float in_min_y, float in_max_y,
@@ -122,7 +122,7 @@ namespace curve_x
 		/*
 		 * Compute the squared magnitude of the point.
 		 */
-		float length_sqr() const 
+		constexpr float length_sqr() const 
 		{
 			return x * x + y * y;
 		}
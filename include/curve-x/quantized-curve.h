@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "curve.h"
+
+namespace curve_x
+{
+	/*
+	 * A compact and evaluation-only representation of a curve,
+	 * intended for large sets of curves held in memory.
+	 *
+	 * Per key, it stores:
+	 * - the time and value on 16 bits each, quantized relatively
+	 *   to the control points extrems of the curve
+	 * - the tangents on 16 bits per axis, quantized relatively to
+	 *   the largest tangent component of the curve
+	 * - both tangent and interpolation modes packed in a byte
+	 *
+	 * This is 13 bytes per key instead of 'sizeof( CurveKey )'.
+	 * Times are stored as absolute values rather than deltas, so
+	 * that the evaluation by time binary-searches them without any
+	 * decoding. Segments are decoded on demand when evaluated.
+	 *
+	 * The resulting error is measured on construction, both by time
+	 * and by geometry, see 'get_time_error' & 'get_geometry_error'.
+	 */
+	class QuantizedCurve
+	{
+	public:
+		QuantizedCurve();
+		explicit QuantizedCurve( const Curve& curve );
+
+		/*
+		 * Evaluate a curve point at given percent, in range from
+		 * 0.0f to 1.0f.
+		 */
+		Point evaluate_by_percent( float t ) const;
+		/*
+		 * Evaluate the Y-axis value corresponding to the given
+		 * time on the X-axis.
+		 */
+		float evaluate_by_time( float time ) const;
+
+		/*
+		 * Decode the key at given index.
+		 * The index must refer to a valid key.
+		 */
+		CurveKey decode_key( int key_id ) const;
+		/*
+		 * Decode the four Bézier points, in global space, of the
+		 * given segment index, same as 'Curve::get_segment_points'.
+		 * The index must refer to a valid segment.
+		 */
+		void decode_segment(
+			int curve_id,
+			Point* p0, Point* p1,
+			Point* p2, Point* p3
+		) const;
+		/*
+		 * Decode all keys into a curve.
+		 */
+		Curve to_curve() const;
+
+		/*
+		 * Returns the index of the segment to evaluate from at
+		 * given time.
+		 */
+		int find_segment_id_by_time( float time ) const;
+
+		/*
+		 * Returns the maximum difference on the Y-axis, evaluated
+		 * by time, measured on samples of the original curve.
+		 */
+		float get_time_error() const;
+		/*
+		 * Returns the maximum distance, evaluated by percent,
+		 * measured on samples of the original curve.
+		 */
+		float get_geometry_error() const;
+
+		/*
+		 * Returns the number of bytes used by the quantized curve,
+		 * including its heap allocations.
+		 */
+		size_t get_memory_usage() const;
+		/*
+		 * Returns the number of bytes used by the given curve,
+		 * including its keys and segments cache allocations.
+		 */
+		static size_t get_memory_usage( const Curve& curve );
+
+		/*
+		 * Returns the number of keys.
+		 */
+		int get_keys_count() const;
+		/*
+		 * Returns the number of segments.
+		 */
+		int get_curves_count() const;
+
+		/*
+		 * Returns whenever the curve holds at least one segment
+		 * to evaluate.
+		 */
+		bool is_valid() const;
+
+	private:
+		/*
+		 * Decode the time of the given key index, in the quantized
+		 * scale, from 0.0f to 65535.0f.
+		 */
+		float _decode_time( int key_id ) const;
+		/*
+		 * Measure the errors with the original curve.
+		 */
+		void _measure_errors( const Curve& curve );
+
+	private:
+		/*
+		 * Quantized times & values of each key, relative to the
+		 * extrems.
+		 */
+		std::vector<uint16_t> _times;
+		std::vector<uint16_t> _values;
+		/*
+		 * Quantized tangents of each key, as left X & Y, then
+		 * right X & Y, relative to the tangents scale.
+		 */
+		std::vector<int16_t> _tangents;
+		/*
+		 * Tangent mode in the low bits and interpolation mode in
+		 * the high bits of each key.
+		 */
+		std::vector<uint8_t> _modes;
+
+		CurveExtrems _extrems {};
+		Point _tangents_scale;
+
+		float _time_error = 0.0f;
+		float _geometry_error = 0.0f;
+	};
+}
\ No newline at end of file
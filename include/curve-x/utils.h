@@ -19,7 +19,7 @@ namespace curve_x
 		 * Types 'float' and 'curve_x::Point' can be safely used.
 		 */
 		template<typename T>
-		static T bezier_interp( T p0, T p1, T p2, T p3, float t )
+		static constexpr T bezier_interp( T p0, T p1, T p2, T p3, float t )
 		{
 			//  Following the formula described here:
 			//  https://en.wikipedia.org/wiki/B%C3%A9zier_curve
@@ -37,10 +37,174 @@ namespace curve_x
 				 + p3 * t3;
 		}
 
+		/*
+		 * Template function computing the first derivative of a 
+		 * Bézier cubic interpolation, with the same requirements 
+		 * as 'bezier_interp'.
+		 */
+		template<typename T>
+		static constexpr T bezier_derivative( T p0, T p1, T p2, T p3, float t )
+		{
+			const float it = 1.0f - t;
+
+			return ( p1 - p0 ) * ( 3.0f * it * it )
+				 + ( p2 - p1 ) * ( 6.0f * it * t )
+				 + ( p3 - p2 ) * ( 3.0f * t * t );
+		}
+
+		/*
+		 * Template function computing the second derivative of a 
+		 * Bézier cubic interpolation, with the same requirements 
+		 * as 'bezier_interp'.
+		 */
+		template<typename T>
+		static constexpr T bezier_second_derivative( T p0, T p1, T p2, T p3, float t )
+		{
+			return ( p2 - p1 * 2.0f + p0 ) * ( 6.0f * ( 1.0f - t ) )
+				 + ( p3 - p2 * 2.0f + p1 ) * ( 6.0f * t );
+		}
+
+		/*
+		 * Solve the quadratic equation 'a*x^2 + b*x + c = 0' and 
+		 * fill given array with its real roots. 
+		 * 
+		 * Degenerates to a linear equation when 'a' is negligible 
+		 * compared to the other coefficients, so that equations of
+		 * any scale are solved alike. Returns the number of roots, 
+		 * from 0 to 2.
+		 */
+		static int solve_quadratic( float a, float b, float c, float* roots )
+		{
+			constexpr float EPSILON = 1e-6f;
+
+			if ( fabsf( a ) <= EPSILON * ( fabsf( b ) + fabsf( c ) ) )
+			{
+				if ( fabsf( b ) <= EPSILON * fabsf( c ) ) return 0;
+
+				roots[0] = -c / b;
+				return 1;
+			}
+
+			const float discriminant = b * b - 4.0f * a * c;
+			if ( discriminant < 0.0f ) return 0;
+
+			//  Numerically stable form, avoiding cancellation
+			const float sqrt_discriminant = sqrtf( discriminant );
+			const float q = -0.5f * ( b + copysignf( sqrt_discriminant, b ) );
+			if ( q == 0.0f )
+			{
+				roots[0] = 0.0f;
+				return 1;
+			}
+
+			roots[0] = q / a;
+			roots[1] = c / q;
+			return 2;
+		}
+
+		/*
+		 * Solve the cubic equation 'a*x^3 + b*x^2 + c*x + d = 0' 
+		 * and fill given array with its real roots.
+		 * 
+		 * Degenerates to a quadratic equation when 'a' is 
+		 * negligible compared to the other coefficients. Roots 
+		 * are computed in double precision. Returns the number 
+		 * of roots, from 0 to 3.
+		 */
+		static int solve_cubic( float a, float b, float c, float d, float* roots )
+		{
+			constexpr float EPSILON = 1e-6f;
+			constexpr double PI = 3.14159265358979323846;
+
+			if ( fabsf( a ) <= EPSILON * ( fabsf( b ) + fabsf( c ) + fabsf( d ) ) )
+				return solve_quadratic( b, c, d, roots );
+
+			//  Depress the normalized cubic with 'x = t - b/3'
+			const double nb = (double)b / a;
+			const double nc = (double)c / a;
+			const double nd = (double)d / a;
+			const double p = nc - nb * nb / 3.0;
+			const double q = 2.0 * nb * nb * nb / 27.0 - nb * nc / 3.0 + nd;
+			const double offset = -nb / 3.0;
+
+			double results[3];
+			int count;
+
+			const double discriminant = q * q / 4.0 + p * p * p / 27.0;
+			if ( discriminant > 0.0 )
+			{
+				//  Single real root, from Cardano's formula
+				const double sqrt_discriminant = sqrt( discriminant );
+				results[0] = cbrt( -q / 2.0 + sqrt_discriminant ) 
+						   + cbrt( -q / 2.0 - sqrt_discriminant );
+				count = 1;
+			}
+			else if ( p == 0.0 )
+			{
+				results[0] = 0.0;
+				count = 1;
+			}
+			else
+			{
+				//  Three real roots, from the trigonometric method
+				const double radius = 2.0 * sqrt( -p / 3.0 );
+				const double cosine = 3.0 * q / ( p * radius );
+				const double angle = acos( fmax( -1.0, fmin( 1.0, cosine ) ) ) / 3.0;
+				for ( int k = 0; k < 3; k++ )
+				{
+					results[k] = radius * cos( angle - 2.0 * PI * k / 3.0 );
+				}
+				count = 3;
+			}
+
+			//  Polish the roots with a Newton step on the original 
+			//  equation, reducing cancellation errors
+			for ( int i = 0; i < count; i++ )
+			{
+				double x = results[i] + offset;
+				const double value = ( ( x + nb ) * x + nc ) * x + nd;
+				const double slope = ( 3.0 * x + 2.0 * nb ) * x + nc;
+				if ( slope != 0.0 )
+				{
+					x -= value / slope;
+				}
+
+				roots[i] = (float)x;
+			}
+
+			return count;
+		}
+
+		/*
+		 * Template function splitting a Bézier cubic at given ratio
+		 * 't' using De Casteljau's algorithm, with the same 
+		 * requirements as 'bezier_interp'.
+		 * 
+		 * Fill given arrays with the four points of the curve 
+		 * before and after 't'.
+		 */
+		template<typename T>
+		static constexpr void bezier_split( 
+			T p0, T p1, T p2, T p3, 
+			float t, 
+			T* left, T* right 
+		)
+		{
+			const T p01 = p0 + ( p1 - p0 ) * t;
+			const T p12 = p1 + ( p2 - p1 ) * t;
+			const T p23 = p2 + ( p3 - p2 ) * t;
+			const T p012 = p01 + ( p12 - p01 ) * t;
+			const T p123 = p12 + ( p23 - p12 ) * t;
+			const T point = p012 + ( p123 - p012 ) * t;
+
+			left[0] = p0, left[1] = p01, left[2] = p012, left[3] = point;
+			right[0] = point, right[1] = p123, right[2] = p23, right[3] = p3;
+		}
+
 		/*
 		 * Remaps a float from range 'a' to range 'b'.
 		 */
-		static float remap(
+		static constexpr float remap(
 			float value,
 			float min_a, float max_a,
 			float min_b, float max_b
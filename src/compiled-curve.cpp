@@ -0,0 +1,181 @@
+#include <curve-x/compiled-curve.h>
+#include <curve-x/curve-kernels.h>
+
+#include <algorithm>
+#include <cassert>
+
+using namespace curve_x;
+
+CompiledCurve::CompiledCurve()
+{}
+
+CompiledCurve::CompiledCurve( const Curve& curve )
+{
+	int keys_count = curve.get_keys_count();
+
+	//  Copy key times
+	_times.reserve( keys_count );
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		_times.push_back( curve.get_key( key_id ).control.x );
+	}
+
+	//  Convert each segment to the power basis
+	int curves_count = curve.get_curves_count();
+	if ( curves_count > 0 )
+	{
+		_segments.reserve( curves_count );
+	}
+	for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
+	{
+		Point p0, p1, p2, p3;
+		curve.get_segment_points( curve_id, &p0, &p1, &p2, &p3 );
+
+		//  Constant and linear segments are lower-degree polynomials,
+		//  so that all segments are evaluated the same way
+		CompiledSegment segment {};
+		segment.a = -p0 + p1 * 3.0f - p2 * 3.0f + p3;
+		segment.b = p0 * 3.0f - p1 * 6.0f + p2 * 3.0f;
+		segment.c = ( p1 - p0 ) * 3.0f;
+		segment.d = p0;
+
+		//  Get the true end of the segment, since constant segments 
+		//  points are all set on the first control point
+		p3 = curve.get_key( curve_id + 1 ).control;
+
+		const float time_diff = p3.x - p0.x;
+		segment.start_time = p0.x;
+		segment.inv_time_diff = time_diff > 0.0f ? 1.0f / time_diff : 0.0f;
+
+		_segments.push_back( segment );
+	}
+
+	if ( keys_count > 0 )
+	{
+		_first_point = curve.get_key( 0 ).control;
+		_last_point = curve.get_key( keys_count - 1 ).control;
+	}
+
+	//  Retrieve the length, computing it from the segments if the
+	//  curve has been modified since
+	if ( curve.is_valid() )
+	{
+		if ( curve.is_length_dirty )
+		{
+			_length = CurveKernels::compute_length( *this );
+		}
+		else
+		{
+			_length = curve.get_length();
+		}
+	}
+
+	_extrems = curve.get_extrems();
+}
+
+Point CompiledCurve::evaluate_by_percent( float t ) const
+{
+	assert( is_valid() );
+
+	const int curves_count = get_curves_count();
+
+	//  The end of the curve is always the last point, even for a
+	//  constant last segment
+	if ( t >= 1.0f ) return _last_point;
+
+	t = fmaxf( t, 0.0f ) * curves_count;
+	const int curve_id = (int)t;
+	t -= (float)curve_id;
+
+	const CompiledSegment& segment = _segments[curve_id];
+	return ( ( segment.a * t + segment.b ) * t + segment.c ) * t
+		 + segment.d;
+}
+
+Point CompiledCurve::evaluate_by_distance( float dist ) const
+{
+	return evaluate_by_percent( dist / _length );
+}
+
+float CompiledCurve::evaluate_by_time( float time ) const
+{
+	assert( is_valid() );
+
+	//  Bound evaluation to first & last points
+	if ( time <= _first_point.x ) return _first_point.y;
+	if ( time >= _last_point.x ) return _last_point.y;
+
+	const CompiledSegment& segment =
+		_segments[find_segment_id_by_time( time )];
+	const float t = ( time - segment.start_time )
+				  * segment.inv_time_diff;
+
+	return ( ( segment.a.y * t + segment.b.y ) * t + segment.c.y ) * t
+		 + segment.d.y;
+}
+
+void CompiledCurve::evaluate_by_time(
+	const float* times,
+	float* values,
+	int count
+) const
+{
+	CurveKernels::evaluate_by_time( *this, times, values, count );
+}
+
+void CompiledCurve::tessellate( int count, Point* points ) const
+{
+	CurveKernels::tessellate( *this, count, points );
+}
+
+int CompiledCurve::find_segment_id_by_time( float time ) const
+{
+	assert( is_valid() );
+
+	//  Find the first key strictly after the given time, ignoring
+	//  the first and last keys which are handled by bounds
+	auto itr = std::upper_bound(
+		_times.begin() + 1,
+		_times.end() - 1,
+		time
+	);
+
+	return (int)( itr - _times.begin() ) - 1;
+}
+
+float CompiledCurve::get_length() const
+{
+	return _length;
+}
+
+const CurveExtrems& CompiledCurve::get_extrems() const
+{
+	return _extrems;
+}
+
+float CompiledCurve::get_key_time( int key_id ) const
+{
+	assert( key_id >= 0 && key_id < get_keys_count() );
+	return _times[key_id];
+}
+
+const CompiledSegment& CompiledCurve::get_segment( int curve_id ) const
+{
+	assert( curve_id >= 0 && curve_id < get_curves_count() );
+	return _segments[curve_id];
+}
+
+int CompiledCurve::get_keys_count() const
+{
+	return (int)_times.size();
+}
+
+int CompiledCurve::get_curves_count() const
+{
+	return (int)_segments.size();
+}
+
+bool CompiledCurve::is_valid() const
+{
+	return !_segments.empty();
+}
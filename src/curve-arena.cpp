@@ -0,0 +1,41 @@
+#include <curve-x/curve-arena.h>
+
+using namespace curve_x;
+
+CurveArena::CurveArena( size_t initial_size )
+	: _resource( initial_size )
+{}
+
+Curve& CurveArena::create_curve()
+{
+	return _curves.emplace_back( &_resource );
+}
+
+Curve& CurveArena::unserialize( const std::string& data )
+{
+	return _curves.emplace_back(
+		_serializer.unserialize( data, &_resource )
+	);
+}
+
+Curve& CurveArena::get_curve( int curve_id )
+{
+	return _curves[curve_id];
+}
+
+int CurveArena::get_curves_count() const
+{
+	return (int)_curves.size();
+}
+
+void CurveArena::release()
+{
+	//  Curves must be destroyed before their memory is released
+	_curves.clear();
+	_resource.release();
+}
+
+std::pmr::memory_resource* CurveArena::get_memory_resource()
+{
+	return &_resource;
+}
@@ -0,0 +1,449 @@
+#include <curve-x/curve-blender.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <curve-x/utils.h>
+
+using namespace curve_x;
+
+/*
+ * Fill the given array with the Y-axis of the four Bézier points
+ * of the given segment, as evaluated by time.
+ */
+static void get_segment_values( const Curve& curve, int curve_id, float* values )
+{
+	const CurveKey& k0 = curve.get_key( curve_id );
+	const CurveKey& k1 = curve.get_key( curve_id + 1 );
+
+	values[0] = k0.control.y;
+	switch ( k0.interpolation_mode )
+	{
+		case InterpolationMode::Constant:
+			values[1] = values[2] = values[3] = k0.control.y;
+			break;
+		case InterpolationMode::Linear:
+			values[1] = k0.control.y + ( k1.control.y - k0.control.y ) / 3.0f;
+			values[2] = k1.control.y + ( k0.control.y - k1.control.y ) / 3.0f;
+			values[3] = k1.control.y;
+			break;
+		default:
+			values[1] = k0.control.y + k0.right_tangent.y;
+			values[2] = k1.control.y + k1.left_tangent.y;
+			values[3] = k1.control.y;
+			break;
+	}
+}
+
+/*
+ * Evaluate the given segment at given time, inside the segment.
+ */
+static float evaluate_segment( const Curve& curve, int curve_id, float time )
+{
+	const float start_time = curve.get_key( curve_id ).control.x;
+	const float time_diff = curve.get_key( curve_id + 1 ).control.x - start_time;
+
+	float values[4];
+	get_segment_values( curve, curve_id, values );
+	if ( time_diff <= 0.0f ) return values[0];
+
+	const float t = ( time - start_time ) / time_diff;
+	return Utils::bezier_interp( values[0], values[1], values[2], values[3], t );
+}
+
+/*
+ * Move the given segment index to the segment containing the
+ * given time, inside the curve. Going forward walks segments one
+ * by one, as times are expected to be sorted.
+ */
+static void move_cursor( const Curve& curve, int* curve_id, float time )
+{
+	if ( time < curve.get_key( *curve_id ).control.x )
+	{
+		int first_key_id, last_key_id;
+		curve.find_evaluation_keys_id_by_time( &first_key_id, &last_key_id, time );
+		*curve_id = first_key_id;
+		return;
+	}
+
+	const int last_curve_id = curve.get_curves_count() - 1;
+	while ( *curve_id < last_curve_id
+		 && curve.get_key( *curve_id + 1 ).control.x <= time )
+	{
+		( *curve_id )++;
+	}
+}
+
+CurveBlender::CurveBlender()
+{}
+
+CurveBlender::CurveBlender(
+	const Curve* const* curves,
+	const float* weights,
+	int count
+)
+{
+	_curves.assign( curves, curves + count );
+	_weights.assign( weights, weights + count );
+	update();
+}
+
+void CurveBlender::add_curve( const Curve* curve, float weight )
+{
+	assert( curve != nullptr && curve->get_keys_count() > 0 );
+
+	_curves.push_back( curve );
+	_weights.push_back( weight );
+	update();
+}
+
+void CurveBlender::clear()
+{
+	_curves.clear();
+	_weights.clear();
+	_is_aligned = true;
+}
+
+void CurveBlender::set_weight( int input_id, float weight )
+{
+	_weights[input_id] = weight;
+}
+
+float CurveBlender::get_weight( int input_id ) const
+{
+	return _weights[input_id];
+}
+
+void CurveBlender::update()
+{
+	_is_aligned = true;
+	if ( _curves.empty() ) return;
+
+	//  Compare the key times of all curves to the first one
+	const Curve& first_curve = *_curves[0];
+	const int keys_count = first_curve.get_keys_count();
+	for ( const Curve* curve : _curves )
+	{
+		if ( curve->get_keys_count() != keys_count )
+		{
+			_is_aligned = false;
+			return;
+		}
+
+		for ( int key_id = 0; key_id < keys_count; key_id++ )
+		{
+			if ( curve->get_key( key_id ).control.x
+			  != first_curve.get_key( key_id ).control.x )
+			{
+				_is_aligned = false;
+				return;
+			}
+		}
+	}
+}
+
+float CurveBlender::evaluate_by_time( float time ) const
+{
+	if ( _curves.empty() ) return 0.0f;
+
+	if ( _is_aligned && _curves[0]->get_keys_count() > 1 )
+	{
+		int first_key_id = 0, last_key_id = 0;
+		const Curve& first_curve = *_curves[0];
+		if ( time > first_curve.get_key( 0 ).control.x
+		  && time < first_curve.get_key( first_curve.get_keys_count() - 1 ).control.x )
+		{
+			first_curve.find_evaluation_keys_id_by_time(
+				&first_key_id, &last_key_id, time );
+		}
+
+		return _evaluate_aligned( first_key_id, time );
+	}
+
+	//  Evaluate each curve separately
+	float value = 0.0f;
+	for ( size_t i = 0; i < _curves.size(); i++ )
+	{
+		value += _curves[i]->evaluate_by_time( time ) * _weights[i];
+	}
+
+	return value;
+}
+
+void CurveBlender::evaluate_by_time(
+	const float* times,
+	float* values,
+	int count
+) const
+{
+	if ( _curves.empty() )
+	{
+		std::fill( values, values + count, 0.0f );
+		return;
+	}
+
+	//  Walk the segments of the first curve only
+	if ( _is_aligned && _curves[0]->get_keys_count() > 1 )
+	{
+		const Curve& first_curve = *_curves[0];
+		int curve_id = 0;
+		for ( int i = 0; i < count; i++ )
+		{
+			move_cursor( first_curve, &curve_id, times[i] );
+			values[i] = _evaluate_aligned( curve_id, times[i] );
+		}
+		return;
+	}
+
+	//  Walk the segments of all curves in lockstep
+	std::vector<int> curve_ids( _curves.size(), 0 );
+	for ( int i = 0; i < count; i++ )
+	{
+		const float time = times[i];
+
+		float value = 0.0f;
+		for ( size_t input_id = 0; input_id < _curves.size(); input_id++ )
+		{
+			const Curve& curve = *_curves[input_id];
+
+			//  Bound evaluation to first & last points
+			const Point& first_point = curve.get_key( 0 ).control;
+			const Point& last_point = curve.get_key( curve.get_keys_count() - 1 ).control;
+			float curve_value;
+			if ( time <= first_point.x )
+			{
+				curve_value = first_point.y;
+			}
+			else if ( time >= last_point.x )
+			{
+				curve_value = last_point.y;
+			}
+			else
+			{
+				move_cursor( curve, &curve_ids[input_id], time );
+				curve_value = evaluate_segment( curve, curve_ids[input_id], time );
+			}
+
+			value += curve_value * _weights[input_id];
+		}
+
+		values[i] = value;
+	}
+}
+
+Curve CurveBlender::bake() const
+{
+	Curve baked_curve;
+	if ( _curves.empty() ) return baked_curve;
+
+	//  Gather the key times of all curves
+	std::vector<float> times;
+	for ( const Curve* curve : _curves )
+	{
+		for ( int key_id = 0; key_id < curve->get_keys_count(); key_id++ )
+		{
+			times.push_back( curve->get_key( key_id ).control.x );
+		}
+	}
+	std::sort( times.begin(), times.end() );
+	times.erase( std::unique( times.begin(), times.end() ), times.end() );
+
+	const int keys_count = (int)times.size();
+	if ( keys_count == 1 )
+	{
+		baked_curve.add_key( CurveKey( Point( times[0], evaluate_by_time( times[0] ) ) ) );
+		return baked_curve;
+	}
+
+	//  Sum the parts of the segments between each consecutive times
+	struct BakedSegment
+	{
+		float values[4];
+		bool is_constant;
+		/*
+		 * Whenever a constant segment of a curve ends with a jump
+		 * at the end of this segment.
+		 */
+		bool has_jump;
+	};
+	std::vector<BakedSegment> segments( keys_count - 1 );
+
+	std::vector<int> curve_ids( _curves.size(), 0 );
+	for ( int i = 0; i < keys_count - 1; i++ )
+	{
+		const float start_time = times[i];
+		const float end_time = times[i + 1];
+
+		BakedSegment& segment = segments[i];
+		segment = { {}, true, false };
+		for ( size_t input_id = 0; input_id < _curves.size(); input_id++ )
+		{
+			const Curve& curve = *_curves[input_id];
+			const float weight = _weights[input_id];
+
+			float segment_values[4];
+			const Point& first_point = curve.get_key( 0 ).control;
+			const Point& last_point = curve.get_key( curve.get_keys_count() - 1 ).control;
+			if ( end_time <= first_point.x || start_time >= last_point.x )
+			{
+				//  Outside of the curve, its value is held
+				const float value = end_time <= first_point.x
+					? first_point.y
+					: last_point.y;
+				std::fill( segment_values, segment_values + 4, value );
+			}
+			else
+			{
+				int& curve_id = curve_ids[input_id];
+				move_cursor( curve, &curve_id, start_time );
+				get_segment_values( curve, curve_id, segment_values );
+
+				const CurveKey& k0 = curve.get_key( curve_id );
+				const CurveKey& k1 = curve.get_key( curve_id + 1 );
+				if ( k0.interpolation_mode == InterpolationMode::Constant )
+				{
+					segment.has_jump |= k1.control.x == end_time
+									 && k1.control.y != k0.control.y;
+				}
+				else
+				{
+					segment.is_constant = false;
+
+					//  Split the segment at both times, knowing that
+					//  no key is between them
+					const float time_diff = k1.control.x - k0.control.x;
+					const float t0 = ( start_time - k0.control.x ) / time_diff;
+					const float t1 = ( end_time - k0.control.x ) / time_diff;
+
+					float left[4], right[4];
+					if ( t1 < 1.0f )
+					{
+						Utils::bezier_split(
+							segment_values[0], segment_values[1],
+							segment_values[2], segment_values[3],
+							t1, left, right );
+						std::copy( left, left + 4, segment_values );
+					}
+					if ( t0 > 0.0f )
+					{
+						Utils::bezier_split(
+							segment_values[0], segment_values[1],
+							segment_values[2], segment_values[3],
+							t0 / t1, left, right );
+						std::copy( right, right + 4, segment_values );
+					}
+				}
+			}
+
+			for ( int j = 0; j < 4; j++ )
+			{
+				segment.values[j] += segment_values[j] * weight;
+			}
+		}
+	}
+
+	//  Create the keys
+	baked_curve.reserve( keys_count );
+	Point left_tangent;
+	for ( int i = 0; i < keys_count - 1; i++ )
+	{
+		const BakedSegment& segment = segments[i];
+		const float third_time_diff = ( times[i + 1] - times[i] ) / 3.0f;
+		const Point right_tangent(
+			third_time_diff,
+			segment.values[1] - segment.values[0]
+		);
+		if ( i == 0 ) left_tangent = -right_tangent;
+
+		baked_curve.add_key( CurveKey(
+			Point( times[i], segment.values[0] ),
+			left_tangent,
+			right_tangent,
+			TangentMode::Broken,
+			segment.is_constant
+				? InterpolationMode::Constant
+				: InterpolationMode::Cubic
+		) );
+
+		left_tangent = Point(
+			-third_time_diff,
+			segment.values[2] - segment.values[3]
+		);
+
+		//  A cubic segment can't end with a jump: end it on a key
+		//  at the same time as the next one, which is never used
+		//  for evaluating by time
+		if ( segment.has_jump && !segment.is_constant )
+		{
+			baked_curve.add_key( CurveKey(
+				Point( times[i + 1], segment.values[3] ),
+				left_tangent,
+				-left_tangent,
+				TangentMode::Broken,
+				InterpolationMode::Constant
+			) );
+		}
+	}
+
+	//  Add the last key, from the values after all curves
+	const float end_time = times.back();
+	baked_curve.add_key( CurveKey(
+		Point( end_time, evaluate_by_time( end_time ) ),
+		left_tangent,
+		-left_tangent,
+		TangentMode::Broken
+	) );
+
+	return baked_curve;
+}
+
+bool CurveBlender::is_aligned() const
+{
+	return _is_aligned;
+}
+
+int CurveBlender::get_curves_count() const
+{
+	return (int)_curves.size();
+}
+
+float CurveBlender::_evaluate_aligned( int curve_id, float time ) const
+{
+	const Curve& first_curve = *_curves[0];
+	const Point& first_point = first_curve.get_key( 0 ).control;
+	const Point& last_point = first_curve.get_key( first_curve.get_keys_count() - 1 ).control;
+
+	//  Bound evaluation to first & last points
+	if ( time <= first_point.x || time >= last_point.x )
+	{
+		const int key_id = time <= first_point.x ? 0 : first_curve.get_keys_count() - 1;
+
+		float value = 0.0f;
+		for ( size_t i = 0; i < _curves.size(); i++ )
+		{
+			value += _curves[i]->get_key( key_id ).control.y * _weights[i];
+		}
+
+		return value;
+	}
+
+	//  Sum the segments, sharing the same time ratio
+	float values[4] {};
+	for ( size_t i = 0; i < _curves.size(); i++ )
+	{
+		float segment_values[4];
+		get_segment_values( *_curves[i], curve_id, segment_values );
+
+		for ( int j = 0; j < 4; j++ )
+		{
+			values[j] += segment_values[j] * _weights[i];
+		}
+	}
+
+	const float start_time = first_curve.get_key( curve_id ).control.x;
+	const float time_diff = first_curve.get_key( curve_id + 1 ).control.x - start_time;
+	if ( time_diff <= 0.0f ) return values[0];
+
+	const float t = ( time - start_time ) / time_diff;
+	return Utils::bezier_interp( values[0], values[1], values[2], values[3], t );
+}
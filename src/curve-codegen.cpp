@@ -0,0 +1,163 @@
+#include <curve-x/curve-codegen.h>
+
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+using namespace curve_x;
+
+static const char* TANGENT_MODE_NAMES[] {
+	"Mirrored",
+	"Aligned",
+	"Broken",
+};
+
+static const char* INTERPOLATION_MODE_NAMES[] {
+	"Constant",
+	"Linear",
+	"Cubic",
+};
+
+CurveCodeGenerator::CurveCodeGenerator( const std::string& namespace_name )
+	: _namespace_name( namespace_name )
+{}
+
+std::string CurveCodeGenerator::generate_header(
+	const std::vector<Curve>& curves,
+	const std::vector<std::string>& names
+)
+{
+	if ( curves.size() != names.size() )
+	{
+		throw std::invalid_argument(
+			"Expected as many names as curves!"
+		);
+	}
+
+	std::stringstream stream;
+	stream << "//  Generated by curve-x-codegen, do not edit.\n";
+	stream << "#pragma once\n\n";
+	stream << "#include <array>\n\n";
+	stream << "#include <curve-x/fixed-curve.h>\n\n";
+
+	if ( !_namespace_name.empty() )
+	{
+		stream << "namespace " << _namespace_name << "\n{\n";
+	}
+
+	for ( size_t i = 0; i < curves.size(); i++ )
+	{
+		if ( i > 0 )
+		{
+			stream << '\n';
+		}
+
+		//  Indent declarations inside the namespace
+		std::istringstream declarations( generate( curves[i], names[i] ) );
+		for ( std::string line; std::getline( declarations, line ); )
+		{
+			if ( !_namespace_name.empty() )
+			{
+				stream << '\t';
+			}
+			stream << line << '\n';
+		}
+	}
+
+	if ( !_namespace_name.empty() )
+	{
+		stream << "}\n";
+	}
+
+	return stream.str();
+}
+
+std::string CurveCodeGenerator::generate(
+	const Curve& curve,
+	const std::string& name
+)
+{
+	std::stringstream stream;
+
+	//  Append keys array
+	int keys_count = curve.get_keys_count();
+	stream << "inline constexpr std::array<curve_x::CurveKey, "
+		   << keys_count << "> " << name << "_keys {{\n";
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		const CurveKey& key = curve.get_key( key_id );
+		stream << "\tcurve_x::CurveKey( ";
+		stream << _to_literal( key.control ) << ", ";
+		stream << _to_literal( key.left_tangent ) << ", ";
+		stream << _to_literal( key.right_tangent ) << ", ";
+		stream << "curve_x::TangentMode::"
+			   << TANGENT_MODE_NAMES[(int)key.tangent_mode] << ", ";
+		stream << "curve_x::InterpolationMode::"
+			   << INTERPOLATION_MODE_NAMES[(int)key.interpolation_mode] 
+			   << " ),\n";
+	}
+	stream << "}};\n";
+
+	//  Append fixed curve, only constructible with a valid curve
+	if ( curve.is_valid() )
+	{
+		stream << "inline constexpr curve_x::FixedCurve<"
+			   << keys_count << "> " << name
+			   << " { " << name << "_keys };\n";
+	}
+
+	//  Append length
+	float length = 0.0f;
+	if ( curve.is_valid() )
+	{
+		Curve copy = curve;
+		length = copy.get_length();
+	}
+	stream << "inline constexpr float " << name << "_length = "
+		   << _to_literal( length ) << ";\n";
+
+	return stream.str();
+}
+
+std::string CurveCodeGenerator::to_identifier( const std::string& str )
+{
+	std::string identifier = str;
+	for ( char& c : identifier )
+	{
+		if ( !std::isalnum( (unsigned char)c ) )
+		{
+			c = '_';
+		}
+	}
+
+	//  Identifiers can't start with a digit
+	if ( identifier.empty() || std::isdigit( (unsigned char)identifier[0] ) )
+	{
+		identifier = "_" + identifier;
+	}
+
+	return identifier;
+}
+
+std::string CurveCodeGenerator::_to_literal( float value )
+{
+	//  9 significant digits are enough to round-trip any float
+	char buffer[32];
+	snprintf( buffer, sizeof( buffer ), "%.9g", value );
+
+	//  Ensure the literal is a float and not an integer
+	std::string literal = buffer;
+	if ( literal.find_first_of( ".e" ) == std::string::npos )
+	{
+		literal += ".0";
+	}
+
+	return literal + "f";
+}
+
+std::string CurveCodeGenerator::_to_literal( const Point& point )
+{
+	return "{ " + _to_literal( point.x ) + ", "
+		 + _to_literal( point.y ) + " }";
+}
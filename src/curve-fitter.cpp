@@ -0,0 +1,475 @@
+#include <curve-x/curve-fitter.h>
+
+#include <algorithm>
+
+#include <curve-x/utils.h>
+
+using namespace curve_x;
+
+/*
+ * Number of least-squares fits of a segment, alternated with
+ * Newton reparameterizations of its samples.
+ */
+static constexpr int REPARAMETERIZATION_ITERATIONS = 4;
+/*
+ * Number of Newton steps refining the nearest location of each
+ * sample before measuring its error.
+ */
+static constexpr int NEWTON_STEPS = 3;
+/*
+ * Maximum number of passes splitting the segments which are no
+ * longer within the tolerance after mirroring their tangents.
+ */
+static constexpr int MIRRORING_ITERATIONS = 16;
+
+static float dot( const Point& a, const Point& b )
+{
+	return a.x * b.x + a.y * b.y;
+}
+
+/*
+ * Refine the ratio of the nearest location on a Bézier cubic to
+ * the given point with a Newton step.
+ */
+static float reparameterize(
+	const Point& p0, const Point& p1,
+	const Point& p2, const Point& p3,
+	const Point& point,
+	float t
+)
+{
+	const Point diff = Utils::bezier_interp( p0, p1, p2, p3, t ) - point;
+	const Point derivative = Utils::bezier_derivative( p0, p1, p2, p3, t );
+	const Point second_derivative =
+		Utils::bezier_second_derivative( p0, p1, p2, p3, t );
+
+	const float numerator = dot( diff, derivative );
+	const float denominator = dot( derivative, derivative )
+							+ dot( diff, second_derivative );
+	if ( denominator == 0.0f ) return t;
+
+	return fminf( fmaxf( t - numerator / denominator, 0.0f ), 1.0f );
+}
+
+CurveFitter::CurveFitter( float tolerance, TangentMode tangent_mode )
+	: _tolerance( tolerance ), _tangent_mode( tangent_mode )
+{}
+
+Curve CurveFitter::fit( const Point* points, int count )
+{
+	return _fit( points, count, false );
+}
+
+Curve CurveFitter::fit_by_time( const Point* points, int count )
+{
+	return _fit( points, count, true );
+}
+
+float CurveFitter::get_max_error() const
+{
+	return _max_error;
+}
+
+Curve CurveFitter::_fit( const Point* points, int count, bool is_by_time )
+{
+	_points = points;
+	_count = count;
+	_is_by_time = is_by_time;
+	_segments.clear();
+	_max_error = 0.0f;
+
+	Curve curve;
+	if ( count <= 0 ) return curve;
+	_parameters.resize( count );
+	if ( count == 1 )
+	{
+		curve.add_key( CurveKey( points[0] ) );
+		return curve;
+	}
+
+	//  Split segments at their maximum error until within the
+	//  tolerance, depth-first so that segments stay ordered
+	std::vector<FittedSegment> stack;
+	stack.push_back( { 0, count - 1 } );
+	while ( !stack.empty() )
+	{
+		FittedSegment segment = stack.back();
+		stack.pop_back();
+
+		if ( is_by_time )
+		{
+			_fit_segment_by_time( &segment );
+		}
+		else
+		{
+			_fit_segment( &segment );
+		}
+
+		if ( segment.max_error > _tolerance
+		  && segment.last_id - segment.first_id > 1 )
+		{
+			const int split_id = segment.max_error_id;
+			stack.push_back( { split_id, segment.last_id } );
+			stack.push_back( { segment.first_id, split_id } );
+			continue;
+		}
+
+		_segments.push_back( segment );
+	}
+
+	if ( _tangent_mode == TangentMode::Mirrored )
+	{
+		_mirror_tangents();
+	}
+
+	//  Create the keys, the outer tangents of the first and last
+	//  keys are mirrored
+	const int segments_count = (int)_segments.size();
+	curve.reserve( segments_count + 1 );
+	for ( int segment_id = 0; segment_id < segments_count; segment_id++ )
+	{
+		const FittedSegment& segment = _segments[segment_id];
+		const Point left_tangent = segment_id > 0
+			? _segments[segment_id - 1].left_tangent
+			: -segment.right_tangent;
+
+		curve.emplace_key(
+			points[segment.first_id],
+			left_tangent,
+			segment.right_tangent,
+			_tangent_mode
+		);
+
+		_max_error = fmaxf( _max_error, segment.max_error );
+	}
+
+	const FittedSegment& last_segment = _segments.back();
+	curve.emplace_key(
+		points[count - 1],
+		last_segment.left_tangent,
+		-last_segment.left_tangent,
+		_tangent_mode
+	);
+
+	return curve;
+}
+
+void CurveFitter::_fit_segment( FittedSegment* segment )
+{
+	const int first_id = segment->first_id;
+	const int last_id = segment->last_id;
+	const Point& p0 = _points[first_id];
+	const Point& p3 = _points[last_id];
+
+	const Point direction_1 = _estimate_direction( first_id, true );
+	const Point direction_2 = _estimate_direction( last_id, false );
+	const float distance = ( p3 - p0 ).length();
+
+	_parameterize_by_chord_length( *segment );
+
+	for ( int iteration = 0; iteration < REPARAMETERIZATION_ITERATIONS; iteration++ )
+	{
+		//  Least squares on the tangents lengths, see "An Algorithm
+		//  for Automatically Fitting Digitized Curves" by Philip J.
+		//  Schneider, in Graphics Gems
+		float c00 = 0.0f, c01 = 0.0f, c11 = 0.0f;
+		float x0 = 0.0f, x1 = 0.0f;
+		for ( int i = first_id; i <= last_id; i++ )
+		{
+			const float t = _parameters[i];
+			const float it = 1.0f - t;
+			const float b0 = it * it * it;
+			const float b1 = 3.0f * it * it * t;
+			const float b2 = 3.0f * it * t * t;
+			const float b3 = t * t * t;
+
+			const Point a1 = direction_1 * b1;
+			const Point a2 = direction_2 * b2;
+			const Point rest = _points[i] - ( p0 * ( b0 + b1 ) + p3 * ( b2 + b3 ) );
+
+			c00 += dot( a1, a1 );
+			c01 += dot( a1, a2 );
+			c11 += dot( a2, a2 );
+			x0 += dot( a1, rest );
+			x1 += dot( a2, rest );
+		}
+
+		float alpha_1 = 0.0f, alpha_2 = 0.0f;
+		const float determinant = c00 * c11 - c01 * c01;
+		if ( determinant != 0.0f )
+		{
+			alpha_1 = ( x0 * c11 - x1 * c01 ) / determinant;
+			alpha_2 = ( c00 * x1 - c01 * x0 ) / determinant;
+		}
+
+		//  Fallback to a third of the distance on degenerate fits
+		const float epsilon = distance * 1e-6f;
+		if ( alpha_1 <= epsilon || alpha_2 <= epsilon )
+		{
+			alpha_1 = alpha_2 = distance / 3.0f;
+		}
+
+		segment->right_tangent = direction_1 * alpha_1;
+		segment->left_tangent = direction_2 * alpha_2;
+
+		_compute_segment_error( segment );
+		if ( segment->max_error <= _tolerance ) break;
+	}
+}
+
+void CurveFitter::_fit_segment_by_time( FittedSegment* segment )
+{
+	const int first_id = segment->first_id;
+	const int last_id = segment->last_id;
+	const Point& p0 = _points[first_id];
+	const Point& p3 = _points[last_id];
+
+	const float time_diff = p3.x - p0.x;
+	const float tangent_x = time_diff / 3.0f;
+
+	//  Parameterize samples by time, same as the evaluation
+	for ( int i = first_id; i <= last_id; i++ )
+	{
+		_parameters[i] = time_diff > 0.0f
+			? ( _points[i].x - p0.x ) / time_diff
+			: 0.0f;
+	}
+
+	//  Aligned and mirrored tangents share the slope estimated
+	//  across their key
+	float offset_1 = _estimate_slope( first_id, true ) * tangent_x;
+	float offset_2 = -_estimate_slope( last_id, false ) * tangent_x;
+
+	//  Broken tangents are free, solve their Y-axis offsets by
+	//  least squares
+	if ( _tangent_mode == TangentMode::Broken )
+	{
+		float c00 = 0.0f, c01 = 0.0f, c11 = 0.0f;
+		float x0 = 0.0f, x1 = 0.0f;
+		for ( int i = first_id; i <= last_id; i++ )
+		{
+			const float t = _parameters[i];
+			const float it = 1.0f - t;
+			const float b0 = it * it * it;
+			const float b1 = 3.0f * it * it * t;
+			const float b2 = 3.0f * it * t * t;
+			const float b3 = t * t * t;
+
+			const float rest = _points[i].y
+				- ( p0.y * ( b0 + b1 ) + p3.y * ( b2 + b3 ) );
+
+			c00 += b1 * b1;
+			c01 += b1 * b2;
+			c11 += b2 * b2;
+			x0 += b1 * rest;
+			x1 += b2 * rest;
+		}
+
+		const float determinant = c00 * c11 - c01 * c01;
+		if ( determinant > 1e-12f )
+		{
+			offset_1 = ( x0 * c11 - x1 * c01 ) / determinant;
+			offset_2 = ( c00 * x1 - c01 * x0 ) / determinant;
+		}
+	}
+
+	segment->right_tangent = Point( tangent_x, offset_1 );
+	segment->left_tangent = Point( -tangent_x, offset_2 );
+
+	_compute_segment_error( segment );
+}
+
+void CurveFitter::_parameterize_by_chord_length( const FittedSegment& segment )
+{
+	const int first_id = segment.first_id;
+	const int last_id = segment.last_id;
+
+	_parameters[first_id] = 0.0f;
+	for ( int i = first_id + 1; i <= last_id; i++ )
+	{
+		_parameters[i] = _parameters[i - 1]
+					   + ( _points[i] - _points[i - 1] ).length();
+	}
+
+	const float total_length = _parameters[last_id];
+	for ( int i = first_id + 1; i <= last_id; i++ )
+	{
+		_parameters[i] = total_length > 0.0f
+			? _parameters[i] / total_length
+			: (float)( i - first_id ) / ( last_id - first_id );
+	}
+}
+
+void CurveFitter::_compute_segment_error( FittedSegment* segment )
+{
+	const int first_id = segment->first_id;
+	const int last_id = segment->last_id;
+	const Point& p0 = _points[first_id];
+	const Point& p3 = _points[last_id];
+	const Point p1 = p0 + segment->right_tangent;
+	const Point p2 = p3 + segment->left_tangent;
+
+	segment->max_error = 0.0f;
+	segment->max_error_id = ( first_id + last_id ) / 2;
+	for ( int i = first_id + 1; i < last_id; i++ )
+	{
+		float error;
+		if ( _is_by_time )
+		{
+			const float y = Utils::bezier_interp(
+				p0.y, p1.y, p2.y, p3.y, _parameters[i] );
+			error = fabsf( y - _points[i].y );
+		}
+		else
+		{
+			for ( int step = 0; step < NEWTON_STEPS; step++ )
+			{
+				_parameters[i] = reparameterize(
+					p0, p1, p2, p3, _points[i], _parameters[i] );
+			}
+
+			const Point point = Utils::bezier_interp(
+				p0, p1, p2, p3, _parameters[i] );
+			error = ( point - _points[i] ).length();
+		}
+
+		if ( error > segment->max_error )
+		{
+			segment->max_error = error;
+			segment->max_error_id = i;
+		}
+	}
+}
+
+Point CurveFitter::_estimate_direction( int sample_id, bool is_segment_start ) const
+{
+	//  Across the key, unless broken or at the ends
+	Point direction;
+	if ( _tangent_mode != TangentMode::Broken
+	  && sample_id > 0 && sample_id < _count - 1 )
+	{
+		direction = _points[sample_id + 1] - _points[sample_id - 1];
+		if ( !is_segment_start )
+		{
+			direction = -direction;
+		}
+	}
+	else
+	{
+		const int other_id = is_segment_start
+			? std::min( sample_id + 1, _count - 1 )
+			: std::max( sample_id - 1, 0 );
+		direction = _points[other_id] - _points[sample_id];
+	}
+
+	if ( direction.length_sqr() == 0.0f ) return direction;
+	return direction.normalized();
+}
+
+float CurveFitter::_estimate_slope( int sample_id, bool is_segment_start ) const
+{
+	int first_id = sample_id, last_id = sample_id;
+	if ( _tangent_mode != TangentMode::Broken
+	  && sample_id > 0 && sample_id < _count - 1 )
+	{
+		first_id = sample_id - 1;
+		last_id = sample_id + 1;
+	}
+	else if ( is_segment_start )
+	{
+		last_id = std::min( sample_id + 1, _count - 1 );
+	}
+	else
+	{
+		first_id = std::max( sample_id - 1, 0 );
+	}
+
+	const Point diff = _points[last_id] - _points[first_id];
+	return diff.x > 0.0f ? diff.y / diff.x : 0.0f;
+}
+
+void CurveFitter::_mirror_tangents()
+{
+	for ( int iteration = 0; ; iteration++ )
+	{
+		//  Shorten the tangents of the shared keys, directions are
+		//  already aligned
+		for ( size_t segment_id = 1; segment_id < _segments.size(); segment_id++ )
+		{
+			Point& left_tangent = _segments[segment_id - 1].left_tangent;
+			Point& right_tangent = _segments[segment_id].right_tangent;
+
+			const float length = fminf(
+				left_tangent.length(),
+				right_tangent.length()
+			);
+			if ( length == 0.0f )
+			{
+				left_tangent = right_tangent = Point( 0.0f, 0.0f );
+				continue;
+			}
+
+			right_tangent = right_tangent.normalized() * length;
+			left_tangent = -right_tangent;
+		}
+
+		//  Keep the remaining errors once out of iterations
+		if ( iteration == MIRRORING_ITERATIONS )
+		{
+			for ( FittedSegment& segment : _segments )
+			{
+				if ( !_is_by_time )
+				{
+					_parameterize_by_chord_length( segment );
+				}
+
+				_compute_segment_error( &segment );
+			}
+			break;
+		}
+
+		//  Split again the segments out of tolerance
+		bool has_split = false;
+		std::vector<FittedSegment> segments;
+		segments.reserve( _segments.size() );
+		for ( FittedSegment& segment : _segments )
+		{
+			//  Tangents changed, restart from the initial parameters
+			if ( !_is_by_time )
+			{
+				_parameterize_by_chord_length( segment );
+			}
+
+			_compute_segment_error( &segment );
+			if ( segment.max_error <= _tolerance
+			  || segment.last_id - segment.first_id <= 1 )
+			{
+				segments.push_back( segment );
+				continue;
+			}
+
+			FittedSegment halves[2] {
+				{ segment.first_id, segment.max_error_id },
+				{ segment.max_error_id, segment.last_id },
+			};
+			for ( FittedSegment& half : halves )
+			{
+				if ( _is_by_time )
+				{
+					_fit_segment_by_time( &half );
+				}
+				else
+				{
+					_fit_segment( &half );
+				}
+
+				segments.push_back( half );
+			}
+
+			has_split = true;
+		}
+
+		_segments = std::move( segments );
+		if ( !has_split ) break;
+	}
+}
@@ -0,0 +1,595 @@
+#include <curve-x/curve-intersector.h>
+
+#include <algorithm>
+
+#include <curve-x/utils.h>
+
+using namespace curve_x;
+
+/*
+ * Maximum number of subdivisions of a pair of segments, in case
+ * the tolerance can't be reached due to floating-point precision.
+ */
+static constexpr int MAX_SUBDIVISION_DEPTH = 48;
+/*
+ * Number of Newton iterations refining intersections found by
+ * subdivision.
+ */
+static constexpr int REFINEMENT_ITERATIONS = 8;
+/*
+ * Percent difference under which intersections are considered
+ * the same, such as when found at the key shared by two segments.
+ */
+static constexpr float DUPLICATE_EPSILON = 1e-5f;
+
+static float dot( const Point& a, const Point& b )
+{
+	return a.x * b.x + a.y * b.y;
+}
+
+static CurveExtrems compute_bounds( const Point* points )
+{
+	CurveExtrems bounds { points[0].x, points[0].x, points[0].y, points[0].y };
+	for ( int i = 1; i < 4; i++ )
+	{
+		bounds.min_x = fminf( bounds.min_x, points[i].x );
+		bounds.max_x = fmaxf( bounds.max_x, points[i].x );
+		bounds.min_y = fminf( bounds.min_y, points[i].y );
+		bounds.max_y = fmaxf( bounds.max_y, points[i].y );
+	}
+
+	return bounds;
+}
+
+static bool is_overlapping( const CurveExtrems& a, const CurveExtrems& b )
+{
+	return a.min_x <= b.max_x && b.min_x <= a.max_x
+		&& a.min_y <= b.max_y && b.min_y <= a.max_y;
+}
+
+/*
+ * Sort the given intersections by percents and remove the
+ * duplicates, either by their percents or by their distance.
+ */
+static void sort_and_remove_duplicates(
+	std::vector<CurveIntersection>* intersections,
+	size_t first_id,
+	float tolerance
+)
+{
+	auto begin = intersections->begin() + first_id;
+	std::sort( begin, intersections->end(),
+		[]( const CurveIntersection& a, const CurveIntersection& b ) {
+			return a.t < b.t || ( a.t == b.t && a.other_t < b.other_t );
+		}
+	);
+
+	auto end = std::unique( begin, intersections->end(),
+		[tolerance]( const CurveIntersection& a, const CurveIntersection& b ) {
+			return ( fabsf( a.t - b.t ) <= DUPLICATE_EPSILON
+				  && fabsf( a.other_t - b.other_t ) <= DUPLICATE_EPSILON )
+				|| ( a.point - b.point ).length() <= tolerance;
+		}
+	);
+	intersections->erase( end, intersections->end() );
+}
+
+/*
+ * Sort the given intersections between curves by percents and
+ * remove the duplicates by their distance, merging the overlapping
+ * ranges sharing an end.
+ */
+static void sort_and_merge_overlaps(
+	std::vector<CurveIntersection>* intersections,
+	size_t first_id,
+	float tolerance
+)
+{
+	auto begin = intersections->begin() + first_id;
+	std::sort( begin, intersections->end(),
+		[]( const CurveIntersection& a, const CurveIntersection& b ) {
+			return a.t < b.t || ( a.t == b.t && a.other_t < b.other_t );
+		}
+	);
+
+	size_t count = first_id;
+	bool is_in_overlap = false;
+	//  Location of the last kept or merged intersection, and
+	//  whether it is still the last element
+	Point last_point;
+	bool has_last = false, is_last_kept = false;
+	for ( auto itr = begin; itr != intersections->end(); itr++ )
+	{
+		const CurveIntersection intersection = *itr;
+		if ( has_last
+		  && ( last_point - intersection.point ).length() <= tolerance )
+		{
+			//  Join an overlap ending where the next one starts
+			if ( is_last_kept && intersection.is_overlap
+			  && ( *intersections )[count - 1].is_overlap
+			  && !is_in_overlap )
+			{
+				count--;
+				is_in_overlap = true;
+				is_last_kept = false;
+			}
+			//  Keep the end of an overlap over a crossing
+			else if ( is_last_kept && intersection.is_overlap
+				   && !( *intersections )[count - 1].is_overlap )
+			{
+				( *intersections )[count - 1] = intersection;
+				is_in_overlap = !is_in_overlap;
+			}
+			continue;
+		}
+
+		( *intersections )[count++] = intersection;
+		if ( intersection.is_overlap )
+		{
+			is_in_overlap = !is_in_overlap;
+		}
+
+		last_point = intersection.point;
+		has_last = is_last_kept = true;
+	}
+	intersections->resize( count );
+}
+
+/*
+ * Returns whether both Bézier cubics are the same, in the same or
+ * in the reverse direction, up to the tolerance.
+ */
+static bool is_coincident(
+	const Point* a,
+	const Point* b,
+	float tolerance,
+	bool* is_reversed
+)
+{
+	*is_reversed = false;
+	for ( int pass = 0; pass < 2; pass++ )
+	{
+		bool is_matching = true;
+		for ( int i = 0; i < 4 && is_matching; i++ )
+		{
+			const Point& other = b[pass == 0 ? i : 3 - i];
+			is_matching = ( a[i] - other ).length() <= tolerance;
+		}
+
+		if ( is_matching )
+		{
+			*is_reversed = pass == 1;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Returns whether the given Bézier cubic is a straight line within
+ * the tolerance, going forward from its first to its last point.
+ */
+static bool is_straight( const Point* points, float tolerance )
+{
+	const Point chord = points[3] - points[0];
+	const float chord_length = chord.length();
+	if ( chord_length <= tolerance ) return false;
+
+	for ( int i = 1; i < 3; i++ )
+	{
+		const Point offset = points[i] - points[0];
+		if ( fabsf( offset.x * chord.y - offset.y * chord.x )
+			> tolerance * chord_length ) return false;
+	}
+
+	//  Forward tangent points keep the cubic from going backward
+	for ( int i = 0; i < 3; i++ )
+	{
+		if ( dot( points[i + 1] - points[i], chord ) < 0.0f ) return false;
+	}
+
+	return true;
+}
+
+/*
+ * Find the ratio at which the given straight Bézier cubic, see
+ * 'is_straight', is the nearest to the given point, by bisection
+ * along its chord.
+ */
+static float find_straight_ratio( const Point* points, const Point& point )
+{
+	const Point chord = points[3] - points[0];
+	const float target = dot( point - points[0], chord );
+
+	float min_t = 0.0f, max_t = 1.0f;
+	for ( int i = 0; i < 24; i++ )
+	{
+		const float t = ( min_t + max_t ) * 0.5f;
+		const Point current = Utils::bezier_interp(
+			points[0], points[1], points[2], points[3], t );
+		if ( dot( current - points[0], chord ) < target )
+		{
+			min_t = t;
+		}
+		else
+		{
+			max_t = t;
+		}
+	}
+
+	return ( min_t + max_t ) * 0.5f;
+}
+
+/*
+ * Subdivide both Bézier cubics until their bounding boxes are
+ * smaller than the tolerance, and append the ratios pairs of the
+ * overlapping ones.
+ */
+static void subdivide(
+	const Point* a, float a_min_t, float a_max_t,
+	const Point* b, float b_min_t, float b_max_t,
+	float tolerance,
+	int depth,
+	std::vector<std::pair<float, float>>* candidates
+)
+{
+	const CurveExtrems a_bounds = compute_bounds( a );
+	const CurveExtrems b_bounds = compute_bounds( b );
+	if ( !is_overlapping( a_bounds, b_bounds ) ) return;
+
+	const float a_size = fmaxf(
+		a_bounds.max_x - a_bounds.min_x,
+		a_bounds.max_y - a_bounds.min_y
+	);
+	const float b_size = fmaxf(
+		b_bounds.max_x - b_bounds.min_x,
+		b_bounds.max_y - b_bounds.min_y
+	);
+	if ( ( a_size <= tolerance && b_size <= tolerance )
+	  || depth >= MAX_SUBDIVISION_DEPTH )
+	{
+		candidates->emplace_back(
+			( a_min_t + a_max_t ) * 0.5f,
+			( b_min_t + b_max_t ) * 0.5f
+		);
+		return;
+	}
+
+	//  Split the largest cubic in halves
+	Point left[4], right[4];
+	if ( a_size >= b_size )
+	{
+		Utils::bezier_split( a[0], a[1], a[2], a[3], 0.5f, left, right );
+
+		const float mid_t = ( a_min_t + a_max_t ) * 0.5f;
+		subdivide( left, a_min_t, mid_t, b, b_min_t, b_max_t,
+			tolerance, depth + 1, candidates );
+		subdivide( right, mid_t, a_max_t, b, b_min_t, b_max_t,
+			tolerance, depth + 1, candidates );
+	}
+	else
+	{
+		Utils::bezier_split( b[0], b[1], b[2], b[3], 0.5f, left, right );
+
+		const float mid_t = ( b_min_t + b_max_t ) * 0.5f;
+		subdivide( a, a_min_t, a_max_t, left, b_min_t, mid_t,
+			tolerance, depth + 1, candidates );
+		subdivide( a, a_min_t, a_max_t, right, mid_t, b_max_t,
+			tolerance, depth + 1, candidates );
+	}
+}
+
+/*
+ * Refine the ratios of an intersection between two Bézier cubics
+ * by solving 'A(u) - B(v) = 0' with Newton's method.
+ */
+static void refine( const Point* a, const Point* b, float* u, float* v )
+{
+	float best_u = *u, best_v = *v;
+	float best_distance = (
+		Utils::bezier_interp( a[0], a[1], a[2], a[3], *u )
+	  - Utils::bezier_interp( b[0], b[1], b[2], b[3], *v )
+	).length_sqr();
+
+	for ( int i = 0; i < REFINEMENT_ITERATIONS; i++ )
+	{
+		const Point diff =
+			Utils::bezier_interp( a[0], a[1], a[2], a[3], *u )
+		  - Utils::bezier_interp( b[0], b[1], b[2], b[3], *v );
+		const Point a_derivative =
+			Utils::bezier_derivative( a[0], a[1], a[2], a[3], *u );
+		const Point b_derivative =
+			Utils::bezier_derivative( b[0], b[1], b[2], b[3], *v );
+
+		//  Solve the 2x2 system formed by the jacobian
+		const float determinant = -a_derivative.x * b_derivative.y
+								+ a_derivative.y * b_derivative.x;
+		if ( determinant == 0.0f ) break;
+
+		const float du = ( -diff.x * b_derivative.y + diff.y * b_derivative.x )
+					   / determinant;
+		const float dv = ( a_derivative.x * diff.y - a_derivative.y * diff.x )
+					   / determinant;
+		*u = fminf( fmaxf( *u - du, 0.0f ), 1.0f );
+		*v = fminf( fmaxf( *v - dv, 0.0f ), 1.0f );
+
+		const float distance = (
+			Utils::bezier_interp( a[0], a[1], a[2], a[3], *u )
+		  - Utils::bezier_interp( b[0], b[1], b[2], b[3], *v )
+		).length_sqr();
+		if ( distance < best_distance )
+		{
+			best_u = *u, best_v = *v;
+			best_distance = distance;
+		}
+	}
+
+	*u = best_u, *v = best_v;
+}
+
+int CurveIntersector::intersect_line(
+	const Curve& curve,
+	const Point& start,
+	const Point& end,
+	LineType line_type,
+	std::vector<CurveIntersection>* intersections
+)
+{
+	const Point direction = end - start;
+	const float direction_length_sqr = direction.length_sqr();
+	if ( direction_length_sqr == 0.0f ) return 0;
+
+	const Point normal( -direction.y, direction.x );
+	const size_t old_size = intersections->size();
+
+	const int curves_count = curve.get_curves_count();
+	for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
+	{
+		if ( curve.get_key( curve_id ).interpolation_mode
+		  == InterpolationMode::Constant ) continue;
+
+		Point points[4];
+		curve.get_segment_points(
+			curve_id,
+			&points[0], &points[1],
+			&points[2], &points[3]
+		);
+
+		//  Signed distances of the points to the line, scaled by
+		//  the direction length
+		float distances[4];
+		float min_distance = INFINITY, max_distance = -INFINITY;
+		for ( int i = 0; i < 4; i++ )
+		{
+			distances[i] = dot( points[i] - start, normal );
+			min_distance = fminf( min_distance, distances[i] );
+			max_distance = fmaxf( max_distance, distances[i] );
+		}
+
+		//  Cull segments with all points on the same side
+		if ( min_distance > 0.0f || max_distance < 0.0f ) continue;
+
+		//  Find where the distance polynomial is zero
+		const float a = -distances[0] + 3.0f * distances[1]
+					  - 3.0f * distances[2] + distances[3];
+		const float b = 3.0f * distances[0] - 6.0f * distances[1]
+					  + 3.0f * distances[2];
+		const float c = 3.0f * ( distances[1] - distances[0] );
+		const float d = distances[0];
+
+		float roots[3];
+		const int roots_count = Utils::solve_cubic( a, b, c, d, roots );
+		for ( int i = 0; i < roots_count; i++ )
+		{
+			constexpr float EPSILON = 1e-5f;
+			if ( roots[i] < -EPSILON || roots[i] > 1.0f + EPSILON )
+				continue;
+
+			const float u = fminf( fmaxf( roots[i], 0.0f ), 1.0f );
+			const Point point = Utils::bezier_interp(
+				points[0], points[1], points[2], points[3], u );
+
+			//  Restrict to the line type
+			const float line_t = dot( point - start, direction )
+							   / direction_length_sqr;
+			if ( line_type != LineType::Line && line_t < 0.0f ) continue;
+			if ( line_type == LineType::Segment && line_t > 1.0f ) continue;
+
+			intersections->push_back( {
+				( curve_id + u ) / curves_count,
+				line_t,
+				point,
+			} );
+		}
+	}
+
+	sort_and_remove_duplicates( intersections, old_size, 0.0f );
+	return (int)( intersections->size() - old_size );
+}
+
+int CurveIntersector::intersect_curves(
+	const Curve& curve_a,
+	const Curve& curve_b,
+	std::vector<CurveIntersection>* intersections,
+	float tolerance
+)
+{
+	struct SegmentBox
+	{
+		CurveExtrems bounds;
+		int curve_id;
+		int owner;
+	};
+
+	//  Gather the bounding boxes of the segments of both curves
+	const Curve* curves[2] { &curve_a, &curve_b };
+	std::vector<SegmentBox> boxes;
+	boxes.reserve( curve_a.get_curves_count() + curve_b.get_curves_count() );
+	for ( int owner = 0; owner < 2; owner++ )
+	{
+		const Curve& curve = *curves[owner];
+		for ( int curve_id = 0; curve_id < curve.get_curves_count(); curve_id++ )
+		{
+			if ( curve.get_key( curve_id ).interpolation_mode
+			  == InterpolationMode::Constant ) continue;
+
+			Point points[4];
+			curve.get_segment_points(
+				curve_id,
+				&points[0], &points[1],
+				&points[2], &points[3]
+			);
+			boxes.push_back( { compute_bounds( points ), curve_id, owner } );
+		}
+	}
+
+	std::sort( boxes.begin(), boxes.end(),
+		[]( const SegmentBox& a, const SegmentBox& b ) {
+			return a.bounds.min_x < b.bounds.min_x;
+		}
+	);
+
+	//  Sweep the boxes along the X-axis, only testing the boxes of
+	//  the other curve overlapping the current one
+	const size_t old_size = intersections->size();
+	std::vector<const SegmentBox*> active_boxes[2];
+	std::vector<std::pair<float, float>> candidates;
+	for ( const SegmentBox& box : boxes )
+	{
+		std::vector<const SegmentBox*>& others = active_boxes[1 - box.owner];
+		others.erase(
+			std::remove_if( others.begin(), others.end(),
+				[&box]( const SegmentBox* other ) {
+					return other->bounds.max_x < box.bounds.min_x;
+				}
+			),
+			others.end()
+		);
+
+		for ( const SegmentBox* other : others )
+		{
+			if ( !is_overlapping( box.bounds, other->bounds ) ) continue;
+
+			const SegmentBox& box_a = box.owner == 0 ? box : *other;
+			const SegmentBox& box_b = box.owner == 0 ? *other : box;
+
+			Point a[4], b[4];
+			curve_a.get_segment_points( box_a.curve_id, &a[0], &a[1], &a[2], &a[3] );
+			curve_b.get_segment_points( box_b.curve_id, &b[0], &b[1], &b[2], &b[3] );
+
+			auto add_intersection = [&]( float u, float v, bool is_overlap )
+			{
+				intersections->push_back( {
+					( box_a.curve_id + u ) / curve_a.get_curves_count(),
+					( box_b.curve_id + v ) / curve_b.get_curves_count(),
+					Utils::bezier_interp( a[0], a[1], a[2], a[3], u ),
+					is_overlap,
+				} );
+			};
+
+			//  Identical segments overlap entirely, skip subdividing
+			//  them down to the tolerance
+			bool is_reversed;
+			if ( is_coincident( a, b, tolerance, &is_reversed ) )
+			{
+				add_intersection( 0.0f, is_reversed ? 1.0f : 0.0f, true );
+				add_intersection( 1.0f, is_reversed ? 0.0f : 1.0f, true );
+				continue;
+			}
+
+			//  Collinear straight segments only meet where their
+			//  projections on the line overlap
+			if ( is_straight( a, tolerance ) && is_straight( b, tolerance ) )
+			{
+				const Point direction = ( a[3] - a[0] ).normalized();
+				const Point normal( -direction.y, direction.x );
+				if ( fabsf( dot( b[0] - a[0], normal ) ) <= tolerance
+				  && fabsf( dot( b[3] - a[0], normal ) ) <= tolerance )
+				{
+					const float a_length = dot( a[3] - a[0], direction );
+					const float b_start = dot( b[0] - a[0], direction );
+					const float b_end = dot( b[3] - a[0], direction );
+
+					const float start = fmaxf( 0.0f, fminf( b_start, b_end ) );
+					const float end = fminf( a_length, fmaxf( b_start, b_end ) );
+					if ( end - start > tolerance )
+					{
+						const Point start_point = a[0] + direction * start;
+						const Point end_point = a[0] + direction * end;
+						add_intersection(
+							find_straight_ratio( a, start_point ),
+							find_straight_ratio( b, start_point ),
+							true
+						);
+						add_intersection(
+							find_straight_ratio( a, end_point ),
+							find_straight_ratio( b, end_point ),
+							true
+						);
+					}
+					else if ( end - start >= -tolerance )
+					{
+						const Point point = a[0] + direction * start;
+						add_intersection(
+							find_straight_ratio( a, point ),
+							find_straight_ratio( b, point ),
+							false
+						);
+					}
+					continue;
+				}
+			}
+
+			candidates.clear();
+			subdivide( a, 0.0f, 1.0f, b, 0.0f, 1.0f, tolerance, 0, &candidates );
+			std::sort( candidates.begin(), candidates.end() );
+
+			//  Group the candidates into runs staying within the
+			//  tolerance of each other curve, a run spanning more
+			//  than the tolerance being an overlap
+			size_t run_start_id = 0;
+			for ( size_t i = 0; i < candidates.size(); i++ )
+			{
+				const auto& candidate = candidates[i];
+
+				const bool is_run_end = i + 1 == candidates.size() || [&]() {
+					const auto& next = candidates[i + 1];
+					const float u = ( candidate.first + next.first ) * 0.5f;
+					const float v = ( candidate.second + next.second ) * 0.5f;
+					return (
+						Utils::bezier_interp( a[0], a[1], a[2], a[3], u )
+					  - Utils::bezier_interp( b[0], b[1], b[2], b[3], v )
+					).length() > tolerance;
+				}();
+				if ( !is_run_end ) continue;
+
+				const auto& run_start = candidates[run_start_id];
+				const float run_length = (
+					Utils::bezier_interp( a[0], a[1], a[2], a[3], run_start.first )
+				  - Utils::bezier_interp( a[0], a[1], a[2], a[3], candidate.first )
+				).length();
+				if ( run_length > tolerance )
+				{
+					//  Newton's method is singular along overlaps,
+					//  keep the subdivision ratios
+					add_intersection( run_start.first, run_start.second, true );
+					add_intersection( candidate.first, candidate.second, true );
+				}
+				else
+				{
+					float u = run_start.first, v = run_start.second;
+					refine( a, b, &u, &v );
+					add_intersection( u, v, false );
+				}
+
+				run_start_id = i + 1;
+			}
+		}
+
+		active_boxes[box.owner].push_back( &box );
+	}
+
+	sort_and_merge_overlaps( intersections, old_size, tolerance );
+	return (int)( intersections->size() - old_size );
+}
@@ -0,0 +1,790 @@
+#include <curve-x/curve-kernels.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) \
+ && ( defined( __x86_64__ ) || defined( __i386__ ) )
+	#define CURVE_X_X86_DISPATCH
+	#include <immintrin.h>
+	#define CURVE_X_TARGET( isa ) __attribute__(( target( isa ) ))
+#endif
+
+using namespace curve_x;
+
+/*
+ * Offsets, in floats, of the coefficients inside a segment, so
+ * that the SIMD implementations gather them across segments.
+ */
+static_assert( sizeof( Point ) == 2 * sizeof( float ), "Point must be two floats" );
+static constexpr int SEGMENT_STRIDE = sizeof( CompiledSegment ) / sizeof( float );
+static constexpr int OFFSET_AX = offsetof( CompiledSegment, a ) / sizeof( float );
+static constexpr int OFFSET_AY = OFFSET_AX + 1;
+static constexpr int OFFSET_BX = offsetof( CompiledSegment, b ) / sizeof( float );
+static constexpr int OFFSET_BY = OFFSET_BX + 1;
+static constexpr int OFFSET_CX = offsetof( CompiledSegment, c ) / sizeof( float );
+static constexpr int OFFSET_CY = OFFSET_CX + 1;
+static constexpr int OFFSET_DX = offsetof( CompiledSegment, d ) / sizeof( float );
+static constexpr int OFFSET_DY = OFFSET_DX + 1;
+static constexpr int OFFSET_START_TIME = offsetof( CompiledSegment, start_time ) / sizeof( float );
+static constexpr int OFFSET_INV_TIME_DIFF = offsetof( CompiledSegment, inv_time_diff ) / sizeof( float );
+
+/*
+ * Number of segment indices searched at once before evaluating
+ * them by time.
+ */
+static constexpr int SEARCH_BLOCK_SIZE = 256;
+
+/*
+ * Curve data needed by the kernels.
+ */
+struct KernelCurve
+{
+	const float* segments;
+	int curves_count;
+
+	Point first_point;
+	Point last_point;
+};
+
+static float evaluate_by_time_scalar(
+	const KernelCurve& curve,
+	int curve_id,
+	float time
+)
+{
+	if ( time <= curve.first_point.x ) return curve.first_point.y;
+	if ( time >= curve.last_point.x ) return curve.last_point.y;
+
+	const float* segment = curve.segments + curve_id * SEGMENT_STRIDE;
+	const float t = ( time - segment[OFFSET_START_TIME] )
+				  * segment[OFFSET_INV_TIME_DIFF];
+
+	return ( ( segment[OFFSET_AY] * t + segment[OFFSET_BY] ) * t
+		   + segment[OFFSET_CY] ) * t + segment[OFFSET_DY];
+}
+
+static float compute_segment_length_scalar(
+	const KernelCurve& curve,
+	int curve_id,
+	int samples_count
+)
+{
+	const float* segment = curve.segments + curve_id * SEGMENT_STRIDE;
+
+	float length = 0.0f;
+	float last_x = segment[OFFSET_DX], last_y = segment[OFFSET_DY];
+	for ( int i = 1; i <= samples_count; i++ )
+	{
+		const float t = (float)i / samples_count;
+		const float x = ( ( segment[OFFSET_AX] * t + segment[OFFSET_BX] ) * t
+						+ segment[OFFSET_CX] ) * t + segment[OFFSET_DX];
+		const float y = ( ( segment[OFFSET_AY] * t + segment[OFFSET_BY] ) * t
+						+ segment[OFFSET_CY] ) * t + segment[OFFSET_DY];
+
+		const float dx = x - last_x, dy = y - last_y;
+		length += sqrtf( dx * dx + dy * dy );
+		last_x = x, last_y = y;
+	}
+
+	return length;
+}
+
+static Point tessellate_scalar( const KernelCurve& curve, int point_id, int count )
+{
+	const float scaled_t = (float)point_id / ( count - 1 ) * curve.curves_count;
+	const int curve_id = std::min( (int)scaled_t, curve.curves_count - 1 );
+	const float t = scaled_t - (float)curve_id;
+
+	const float* segment = curve.segments + curve_id * SEGMENT_STRIDE;
+	return Point(
+		( ( segment[OFFSET_AX] * t + segment[OFFSET_BX] ) * t
+		+ segment[OFFSET_CX] ) * t + segment[OFFSET_DX],
+		( ( segment[OFFSET_AY] * t + segment[OFFSET_BY] ) * t
+		+ segment[OFFSET_CY] ) * t + segment[OFFSET_DY]
+	);
+}
+
+#ifdef CURVE_X_X86_DISPATCH
+
+/*
+ * SSE4.2 implementation, loading coefficients one by one since
+ * there are no gather instructions.
+ */
+#define SSE_GATHER( base, ids, offset ) _mm_setr_ps( \
+	( base )[( ids )[0] * SEGMENT_STRIDE + ( offset )], \
+	( base )[( ids )[1] * SEGMENT_STRIDE + ( offset )], \
+	( base )[( ids )[2] * SEGMENT_STRIDE + ( offset )], \
+	( base )[( ids )[3] * SEGMENT_STRIDE + ( offset )] )
+#define SSE_HORNER( a, b, c, d, t ) _mm_add_ps( _mm_mul_ps( _mm_add_ps( \
+	_mm_mul_ps( _mm_add_ps( _mm_mul_ps( a, t ), b ), t ), c ), t ), d )
+
+CURVE_X_TARGET( "sse4.2" )
+static int evaluate_by_time_sse42(
+	const KernelCurve& curve,
+	const int* curve_ids,
+	const float* times,
+	float* values,
+	int count
+)
+{
+	const __m128 first_time = _mm_set1_ps( curve.first_point.x );
+	const __m128 first_value = _mm_set1_ps( curve.first_point.y );
+	const __m128 last_time = _mm_set1_ps( curve.last_point.x );
+	const __m128 last_value = _mm_set1_ps( curve.last_point.y );
+
+	int i = 0;
+	for ( ; i + 4 <= count; i += 4 )
+	{
+		const int* ids = curve_ids + i;
+		const __m128 time = _mm_loadu_ps( times + i );
+		const __m128 t = _mm_mul_ps(
+			_mm_sub_ps( time, SSE_GATHER( curve.segments, ids, OFFSET_START_TIME ) ),
+			SSE_GATHER( curve.segments, ids, OFFSET_INV_TIME_DIFF )
+		);
+
+		__m128 value = SSE_HORNER(
+			SSE_GATHER( curve.segments, ids, OFFSET_AY ),
+			SSE_GATHER( curve.segments, ids, OFFSET_BY ),
+			SSE_GATHER( curve.segments, ids, OFFSET_CY ),
+			SSE_GATHER( curve.segments, ids, OFFSET_DY ),
+			t
+		);
+		value = _mm_blendv_ps( value, first_value, _mm_cmple_ps( time, first_time ) );
+		value = _mm_blendv_ps( value, last_value, _mm_cmpge_ps( time, last_time ) );
+		_mm_storeu_ps( values + i, value );
+	}
+
+	return i;
+}
+
+CURVE_X_TARGET( "sse4.2" )
+static int compute_length_sse42(
+	const KernelCurve& curve,
+	int samples_count,
+	float* length
+)
+{
+	__m128 lengths = _mm_setzero_ps();
+
+	int curve_id = 0;
+	for ( ; curve_id + 4 <= curve.curves_count; curve_id += 4 )
+	{
+		const int ids[4] { curve_id, curve_id + 1, curve_id + 2, curve_id + 3 };
+		const __m128 ax = SSE_GATHER( curve.segments, ids, OFFSET_AX );
+		const __m128 ay = SSE_GATHER( curve.segments, ids, OFFSET_AY );
+		const __m128 bx = SSE_GATHER( curve.segments, ids, OFFSET_BX );
+		const __m128 by = SSE_GATHER( curve.segments, ids, OFFSET_BY );
+		const __m128 cx = SSE_GATHER( curve.segments, ids, OFFSET_CX );
+		const __m128 cy = SSE_GATHER( curve.segments, ids, OFFSET_CY );
+		const __m128 dx = SSE_GATHER( curve.segments, ids, OFFSET_DX );
+		const __m128 dy = SSE_GATHER( curve.segments, ids, OFFSET_DY );
+
+		__m128 last_x = dx, last_y = dy;
+		for ( int i = 1; i <= samples_count; i++ )
+		{
+			const __m128 t = _mm_set1_ps( (float)i / samples_count );
+			const __m128 x = SSE_HORNER( ax, bx, cx, dx, t );
+			const __m128 y = SSE_HORNER( ay, by, cy, dy, t );
+
+			const __m128 diff_x = _mm_sub_ps( x, last_x );
+			const __m128 diff_y = _mm_sub_ps( y, last_y );
+			lengths = _mm_add_ps( lengths, _mm_sqrt_ps( _mm_add_ps(
+				_mm_mul_ps( diff_x, diff_x ), _mm_mul_ps( diff_y, diff_y ) ) ) );
+			last_x = x, last_y = y;
+		}
+	}
+
+	float lanes[4];
+	_mm_storeu_ps( lanes, lengths );
+	*length = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+	return curve_id;
+}
+
+CURVE_X_TARGET( "sse4.2" )
+static int tessellate_sse42(
+	const KernelCurve& curve,
+	int count,
+	Point* points
+)
+{
+	const __m128 lanes = _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f );
+	const __m128 last_curve_id = _mm_set1_ps( (float)( curve.curves_count - 1 ) );
+	const __m128 divisor = _mm_set1_ps( (float)( count - 1 ) );
+	const __m128 curves_count = _mm_set1_ps( (float)curve.curves_count );
+
+	int i = 0;
+	for ( ; i + 4 <= count - 1; i += 4 )
+	{
+		const __m128 point_ids = _mm_add_ps( _mm_set1_ps( (float)i ), lanes );
+		const __m128 scaled_t = _mm_mul_ps( _mm_div_ps( point_ids, divisor ), curves_count );
+		const __m128 curve_id = _mm_min_ps( _mm_floor_ps( scaled_t ), last_curve_id );
+		const __m128 t = _mm_sub_ps( scaled_t, curve_id );
+
+		int ids[4];
+		_mm_storeu_si128( (__m128i*)ids, _mm_cvttps_epi32( curve_id ) );
+
+		const __m128 x = SSE_HORNER(
+			SSE_GATHER( curve.segments, ids, OFFSET_AX ),
+			SSE_GATHER( curve.segments, ids, OFFSET_BX ),
+			SSE_GATHER( curve.segments, ids, OFFSET_CX ),
+			SSE_GATHER( curve.segments, ids, OFFSET_DX ),
+			t
+		);
+		const __m128 y = SSE_HORNER(
+			SSE_GATHER( curve.segments, ids, OFFSET_AY ),
+			SSE_GATHER( curve.segments, ids, OFFSET_BY ),
+			SSE_GATHER( curve.segments, ids, OFFSET_CY ),
+			SSE_GATHER( curve.segments, ids, OFFSET_DY ),
+			t
+		);
+
+		float* output = (float*)( points + i );
+		_mm_storeu_ps( output, _mm_unpacklo_ps( x, y ) );
+		_mm_storeu_ps( output + 4, _mm_unpackhi_ps( x, y ) );
+	}
+
+	return i;
+}
+
+/*
+ * AVX2 implementation, gathering coefficients across segments.
+ */
+#define AVX2_GATHER( base, indices, offset ) \
+	_mm256_i32gather_ps( ( base ) + ( offset ), indices, sizeof( float ) )
+#define AVX2_HORNER( a, b, c, d, t ) _mm256_add_ps( _mm256_mul_ps( _mm256_add_ps( \
+	_mm256_mul_ps( _mm256_add_ps( _mm256_mul_ps( a, t ), b ), t ), c ), t ), d )
+
+CURVE_X_TARGET( "avx2" )
+static int evaluate_by_time_avx2(
+	const KernelCurve& curve,
+	const int* curve_ids,
+	const float* times,
+	float* values,
+	int count
+)
+{
+	const __m256i stride = _mm256_set1_epi32( SEGMENT_STRIDE );
+	const __m256 first_time = _mm256_set1_ps( curve.first_point.x );
+	const __m256 first_value = _mm256_set1_ps( curve.first_point.y );
+	const __m256 last_time = _mm256_set1_ps( curve.last_point.x );
+	const __m256 last_value = _mm256_set1_ps( curve.last_point.y );
+
+	int i = 0;
+	for ( ; i + 8 <= count; i += 8 )
+	{
+		const __m256i indices = _mm256_mullo_epi32(
+			_mm256_loadu_si256( (const __m256i*)( curve_ids + i ) ), stride );
+		const __m256 time = _mm256_loadu_ps( times + i );
+		const __m256 t = _mm256_mul_ps(
+			_mm256_sub_ps( time, AVX2_GATHER( curve.segments, indices, OFFSET_START_TIME ) ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_INV_TIME_DIFF )
+		);
+
+		__m256 value = AVX2_HORNER(
+			AVX2_GATHER( curve.segments, indices, OFFSET_AY ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_BY ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_CY ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_DY ),
+			t
+		);
+		value = _mm256_blendv_ps( value, first_value,
+			_mm256_cmp_ps( time, first_time, _CMP_LE_OQ ) );
+		value = _mm256_blendv_ps( value, last_value,
+			_mm256_cmp_ps( time, last_time, _CMP_GE_OQ ) );
+		_mm256_storeu_ps( values + i, value );
+	}
+
+	return i;
+}
+
+CURVE_X_TARGET( "avx2" )
+static int compute_length_avx2(
+	const KernelCurve& curve,
+	int samples_count,
+	float* length
+)
+{
+	const __m256i lanes = _mm256_setr_epi32(
+		0, SEGMENT_STRIDE, 2 * SEGMENT_STRIDE, 3 * SEGMENT_STRIDE,
+		4 * SEGMENT_STRIDE, 5 * SEGMENT_STRIDE, 6 * SEGMENT_STRIDE, 7 * SEGMENT_STRIDE
+	);
+	__m256 lengths = _mm256_setzero_ps();
+
+	int curve_id = 0;
+	for ( ; curve_id + 8 <= curve.curves_count; curve_id += 8 )
+	{
+		const __m256i indices = _mm256_add_epi32( lanes,
+			_mm256_set1_epi32( curve_id * SEGMENT_STRIDE ) );
+		const __m256 ax = AVX2_GATHER( curve.segments, indices, OFFSET_AX );
+		const __m256 ay = AVX2_GATHER( curve.segments, indices, OFFSET_AY );
+		const __m256 bx = AVX2_GATHER( curve.segments, indices, OFFSET_BX );
+		const __m256 by = AVX2_GATHER( curve.segments, indices, OFFSET_BY );
+		const __m256 cx = AVX2_GATHER( curve.segments, indices, OFFSET_CX );
+		const __m256 cy = AVX2_GATHER( curve.segments, indices, OFFSET_CY );
+		const __m256 dx = AVX2_GATHER( curve.segments, indices, OFFSET_DX );
+		const __m256 dy = AVX2_GATHER( curve.segments, indices, OFFSET_DY );
+
+		__m256 last_x = dx, last_y = dy;
+		for ( int i = 1; i <= samples_count; i++ )
+		{
+			const __m256 t = _mm256_set1_ps( (float)i / samples_count );
+			const __m256 x = AVX2_HORNER( ax, bx, cx, dx, t );
+			const __m256 y = AVX2_HORNER( ay, by, cy, dy, t );
+
+			const __m256 diff_x = _mm256_sub_ps( x, last_x );
+			const __m256 diff_y = _mm256_sub_ps( y, last_y );
+			lengths = _mm256_add_ps( lengths, _mm256_sqrt_ps( _mm256_add_ps(
+				_mm256_mul_ps( diff_x, diff_x ), _mm256_mul_ps( diff_y, diff_y ) ) ) );
+			last_x = x, last_y = y;
+		}
+	}
+
+	float lanes_lengths[8];
+	_mm256_storeu_ps( lanes_lengths, lengths );
+	*length = 0.0f;
+	for ( float lane_length : lanes_lengths )
+	{
+		*length += lane_length;
+	}
+
+	return curve_id;
+}
+
+CURVE_X_TARGET( "avx2" )
+static int tessellate_avx2(
+	const KernelCurve& curve,
+	int count,
+	Point* points
+)
+{
+	const __m256 lanes = _mm256_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f );
+	const __m256i stride = _mm256_set1_epi32( SEGMENT_STRIDE );
+	const __m256 last_curve_id = _mm256_set1_ps( (float)( curve.curves_count - 1 ) );
+	const __m256 divisor = _mm256_set1_ps( (float)( count - 1 ) );
+	const __m256 curves_count = _mm256_set1_ps( (float)curve.curves_count );
+
+	int i = 0;
+	for ( ; i + 8 <= count - 1; i += 8 )
+	{
+		const __m256 point_ids = _mm256_add_ps( _mm256_set1_ps( (float)i ), lanes );
+		const __m256 scaled_t = _mm256_mul_ps( _mm256_div_ps( point_ids, divisor ), curves_count );
+		const __m256 curve_id = _mm256_min_ps( _mm256_floor_ps( scaled_t ), last_curve_id );
+		const __m256 t = _mm256_sub_ps( scaled_t, curve_id );
+		const __m256i indices = _mm256_mullo_epi32( _mm256_cvttps_epi32( curve_id ), stride );
+
+		const __m256 x = AVX2_HORNER(
+			AVX2_GATHER( curve.segments, indices, OFFSET_AX ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_BX ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_CX ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_DX ),
+			t
+		);
+		const __m256 y = AVX2_HORNER(
+			AVX2_GATHER( curve.segments, indices, OFFSET_AY ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_BY ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_CY ),
+			AVX2_GATHER( curve.segments, indices, OFFSET_DY ),
+			t
+		);
+
+		//  Interleave coordinates, unpacking within 128-bit lanes
+		const __m256 low = _mm256_unpacklo_ps( x, y );
+		const __m256 high = _mm256_unpackhi_ps( x, y );
+		float* output = (float*)( points + i );
+		_mm256_storeu_ps( output, _mm256_permute2f128_ps( low, high, 0x20 ) );
+		_mm256_storeu_ps( output + 8, _mm256_permute2f128_ps( low, high, 0x31 ) );
+	}
+
+	return i;
+}
+
+/*
+ * AVX-512 implementation, same as AVX2 with twice the lanes.
+ *
+ * Unmasked forms of some intrinsics start from undefined vectors,
+ * which GCC reports as uninitialized: their masked forms are used
+ * instead, with all lanes enabled and zeroed sources.
+ */
+static constexpr __mmask16 AVX512_ALL_LANES = 0xFFFF;
+
+#define AVX512_GATHER( base, indices, offset ) _mm512_mask_i32gather_ps( \
+	_mm512_setzero_ps(), AVX512_ALL_LANES, indices, ( base ) + ( offset ), sizeof( float ) )
+#define AVX512_HORNER( a, b, c, d, t ) _mm512_add_ps( _mm512_mul_ps( _mm512_add_ps( \
+	_mm512_mul_ps( _mm512_add_ps( _mm512_mul_ps( a, t ), b ), t ), c ), t ), d )
+
+CURVE_X_TARGET( "avx512f" )
+static int evaluate_by_time_avx512(
+	const KernelCurve& curve,
+	const int* curve_ids,
+	const float* times,
+	float* values,
+	int count
+)
+{
+	const __m512i stride = _mm512_set1_epi32( SEGMENT_STRIDE );
+	const __m512 first_time = _mm512_set1_ps( curve.first_point.x );
+	const __m512 first_value = _mm512_set1_ps( curve.first_point.y );
+	const __m512 last_time = _mm512_set1_ps( curve.last_point.x );
+	const __m512 last_value = _mm512_set1_ps( curve.last_point.y );
+
+	int i = 0;
+	for ( ; i + 16 <= count; i += 16 )
+	{
+		const __m512i indices = _mm512_mullo_epi32(
+			_mm512_loadu_si512( curve_ids + i ), stride );
+		const __m512 time = _mm512_loadu_ps( times + i );
+		const __m512 t = _mm512_mul_ps(
+			_mm512_sub_ps( time, AVX512_GATHER( curve.segments, indices, OFFSET_START_TIME ) ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_INV_TIME_DIFF )
+		);
+
+		__m512 value = AVX512_HORNER(
+			AVX512_GATHER( curve.segments, indices, OFFSET_AY ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_BY ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_CY ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_DY ),
+			t
+		);
+		value = _mm512_mask_blend_ps(
+			_mm512_cmp_ps_mask( time, first_time, _CMP_LE_OQ ), value, first_value );
+		value = _mm512_mask_blend_ps(
+			_mm512_cmp_ps_mask( time, last_time, _CMP_GE_OQ ), value, last_value );
+		_mm512_storeu_ps( values + i, value );
+	}
+
+	return i;
+}
+
+CURVE_X_TARGET( "avx512f" )
+static int compute_length_avx512(
+	const KernelCurve& curve,
+	int samples_count,
+	float* length
+)
+{
+	const __m512i lanes = _mm512_mullo_epi32(
+		_mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ),
+		_mm512_set1_epi32( SEGMENT_STRIDE )
+	);
+	__m512 lengths = _mm512_setzero_ps();
+
+	int curve_id = 0;
+	for ( ; curve_id + 16 <= curve.curves_count; curve_id += 16 )
+	{
+		const __m512i indices = _mm512_add_epi32( lanes,
+			_mm512_set1_epi32( curve_id * SEGMENT_STRIDE ) );
+		const __m512 ax = AVX512_GATHER( curve.segments, indices, OFFSET_AX );
+		const __m512 ay = AVX512_GATHER( curve.segments, indices, OFFSET_AY );
+		const __m512 bx = AVX512_GATHER( curve.segments, indices, OFFSET_BX );
+		const __m512 by = AVX512_GATHER( curve.segments, indices, OFFSET_BY );
+		const __m512 cx = AVX512_GATHER( curve.segments, indices, OFFSET_CX );
+		const __m512 cy = AVX512_GATHER( curve.segments, indices, OFFSET_CY );
+		const __m512 dx = AVX512_GATHER( curve.segments, indices, OFFSET_DX );
+		const __m512 dy = AVX512_GATHER( curve.segments, indices, OFFSET_DY );
+
+		__m512 last_x = dx, last_y = dy;
+		for ( int i = 1; i <= samples_count; i++ )
+		{
+			const __m512 t = _mm512_set1_ps( (float)i / samples_count );
+			const __m512 x = AVX512_HORNER( ax, bx, cx, dx, t );
+			const __m512 y = AVX512_HORNER( ay, by, cy, dy, t );
+
+			const __m512 diff_x = _mm512_sub_ps( x, last_x );
+			const __m512 diff_y = _mm512_sub_ps( y, last_y );
+			lengths = _mm512_add_ps( lengths, _mm512_maskz_sqrt_ps( AVX512_ALL_LANES,
+				_mm512_add_ps( _mm512_mul_ps( diff_x, diff_x ),
+							   _mm512_mul_ps( diff_y, diff_y ) ) ) );
+			last_x = x, last_y = y;
+		}
+	}
+
+	float lanes_lengths[16];
+	_mm512_storeu_ps( lanes_lengths, lengths );
+	*length = 0.0f;
+	for ( float lane_length : lanes_lengths )
+	{
+		*length += lane_length;
+	}
+
+	return curve_id;
+}
+
+CURVE_X_TARGET( "avx512f" )
+static int tessellate_avx512(
+	const KernelCurve& curve,
+	int count,
+	Point* points
+)
+{
+	const __m512 lanes = _mm512_setr_ps(
+		0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+		8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f
+	);
+	const __m512i stride = _mm512_set1_epi32( SEGMENT_STRIDE );
+	const __m512 last_curve_id = _mm512_set1_ps( (float)( curve.curves_count - 1 ) );
+	const __m512 divisor = _mm512_set1_ps( (float)( count - 1 ) );
+	const __m512 curves_count = _mm512_set1_ps( (float)curve.curves_count );
+
+	//  Interleaving indices of X (0-15) & Y (16-31) coordinates
+	const __m512i low_order = _mm512_setr_epi32(
+		0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23 );
+	const __m512i high_order = _mm512_setr_epi32(
+		8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31 );
+
+	int i = 0;
+	for ( ; i + 16 <= count - 1; i += 16 )
+	{
+		const __m512 point_ids = _mm512_add_ps( _mm512_set1_ps( (float)i ), lanes );
+		const __m512 scaled_t = _mm512_mul_ps( _mm512_div_ps( point_ids, divisor ), curves_count );
+		const __m512 curve_id = _mm512_maskz_min_ps( AVX512_ALL_LANES,
+			_mm512_maskz_roundscale_ps( AVX512_ALL_LANES, scaled_t, _MM_FROUND_TO_NEG_INF ),
+			last_curve_id );
+		const __m512 t = _mm512_sub_ps( scaled_t, curve_id );
+		const __m512i indices = _mm512_mullo_epi32(
+			_mm512_maskz_cvttps_epi32( AVX512_ALL_LANES, curve_id ), stride );
+
+		const __m512 x = AVX512_HORNER(
+			AVX512_GATHER( curve.segments, indices, OFFSET_AX ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_BX ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_CX ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_DX ),
+			t
+		);
+		const __m512 y = AVX512_HORNER(
+			AVX512_GATHER( curve.segments, indices, OFFSET_AY ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_BY ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_CY ),
+			AVX512_GATHER( curve.segments, indices, OFFSET_DY ),
+			t
+		);
+
+		float* output = (float*)( points + i );
+		_mm512_storeu_ps( output, _mm512_permutex2var_ps( x, low_order, y ) );
+		_mm512_storeu_ps( output + 16, _mm512_permutex2var_ps( x, high_order, y ) );
+	}
+
+	return i;
+}
+
+#endif
+
+/*
+ * Implementations of each level, processing as many elements as
+ * their lanes allow and returning how many, the rest being done by
+ * the scalar implementation.
+ */
+struct KernelTable
+{
+	int ( *evaluate_by_time )(
+		const KernelCurve& curve,
+		const int* curve_ids,
+		const float* times,
+		float* values,
+		int count
+	);
+	int ( *compute_length )(
+		const KernelCurve& curve,
+		int samples_count,
+		float* length
+	);
+	int ( *tessellate )(
+		const KernelCurve& curve,
+		int count,
+		Point* points
+	);
+};
+
+static const KernelTable* get_kernel_table( SimdLevel level )
+{
+#ifdef CURVE_X_X86_DISPATCH
+	static const KernelTable SSE42_TABLE {
+		&evaluate_by_time_sse42, &compute_length_sse42, &tessellate_sse42 };
+	static const KernelTable AVX2_TABLE {
+		&evaluate_by_time_avx2, &compute_length_avx2, &tessellate_avx2 };
+	static const KernelTable AVX512_TABLE {
+		&evaluate_by_time_avx512, &compute_length_avx512, &tessellate_avx512 };
+
+	switch ( level )
+	{
+		case SimdLevel::SSE42:
+			return &SSE42_TABLE;
+		case SimdLevel::AVX2:
+			return &AVX2_TABLE;
+		case SimdLevel::AVX512:
+			return &AVX512_TABLE;
+		default:
+			break;
+	}
+#endif
+
+	return nullptr;
+}
+
+/*
+ * Returns the level used by the kernels, detected on first call.
+ */
+static std::atomic<SimdLevel>& get_current_level()
+{
+	static std::atomic<SimdLevel> level { CurveKernels::detect_simd_level() };
+	return level;
+}
+
+static KernelCurve get_kernel_curve( const CompiledCurve& curve )
+{
+	return {
+		(const float*)&curve.get_segment( 0 ),
+		curve.get_curves_count(),
+		curve.evaluate_by_percent( 0.0f ),
+		curve.evaluate_by_percent( 1.0f ),
+	};
+}
+
+void CurveKernels::evaluate_by_time(
+	const CompiledCurve& curve,
+	const float* times,
+	float* values,
+	int count
+)
+{
+	assert( curve.is_valid() );
+
+	const KernelCurve kernel_curve = get_kernel_curve( curve );
+	const KernelTable* table = get_kernel_table( get_simd_level() );
+
+	int curve_ids[SEARCH_BLOCK_SIZE];
+	int curve_id = 0;
+	for ( int first_id = 0; first_id < count; first_id += SEARCH_BLOCK_SIZE )
+	{
+		const int block_count = std::min( SEARCH_BLOCK_SIZE, count - first_id );
+		for ( int i = 0; i < block_count; i++ )
+		{
+			//  Reuse the previous segment for sorted or coherent times
+			const float time = times[first_id + i];
+			const float* segment = kernel_curve.segments + curve_id * SEGMENT_STRIDE;
+			const float end_time = curve_id + 1 < kernel_curve.curves_count
+				? segment[SEGMENT_STRIDE + OFFSET_START_TIME]
+				: kernel_curve.last_point.x;
+			if ( !( time >= segment[OFFSET_START_TIME] && time < end_time ) )
+			{
+				curve_id = curve.find_segment_id_by_time( time );
+			}
+			curve_ids[i] = curve_id;
+		}
+
+		int i = 0;
+		if ( table != nullptr )
+		{
+			i = table->evaluate_by_time(
+				kernel_curve, curve_ids,
+				times + first_id, values + first_id, block_count );
+		}
+		for ( ; i < block_count; i++ )
+		{
+			values[first_id + i] = evaluate_by_time_scalar(
+				kernel_curve, curve_ids[i], times[first_id + i] );
+		}
+	}
+}
+
+float CurveKernels::compute_length( const CompiledCurve& curve, float steps )
+{
+	if ( !curve.is_valid() ) return 0.0f;
+
+	const KernelCurve kernel_curve = get_kernel_curve( curve );
+	const KernelTable* table = get_kernel_table( get_simd_level() );
+
+	//  Keep the same samples density as 'Curve::compute_length'
+	const int samples_count = std::max( 1,
+		(int)ceilf( 1.0f / ( steps * kernel_curve.curves_count ) ) );
+
+	float length = 0.0f;
+	int curve_id = 0;
+	if ( table != nullptr )
+	{
+		curve_id = table->compute_length( kernel_curve, samples_count, &length );
+	}
+	for ( ; curve_id < kernel_curve.curves_count; curve_id++ )
+	{
+		length += compute_segment_length_scalar( kernel_curve, curve_id, samples_count );
+	}
+
+	return length;
+}
+
+void CurveKernels::tessellate(
+	const CompiledCurve& curve,
+	int count,
+	Point* points
+)
+{
+	assert( curve.is_valid() );
+	if ( count <= 0 ) return;
+	if ( count == 1 )
+	{
+		points[0] = curve.evaluate_by_percent( 0.0f );
+		return;
+	}
+
+	const KernelCurve kernel_curve = get_kernel_curve( curve );
+	const KernelTable* table = get_kernel_table( get_simd_level() );
+
+	int i = 0;
+	if ( table != nullptr )
+	{
+		i = table->tessellate( kernel_curve, count, points );
+	}
+	for ( ; i < count - 1; i++ )
+	{
+		points[i] = tessellate_scalar( kernel_curve, i, count );
+	}
+
+	//  The end of the curve is always the last point, even for a
+	//  constant last segment
+	points[count - 1] = curve.evaluate_by_percent( 1.0f );
+}
+
+SimdLevel CurveKernels::detect_simd_level()
+{
+#ifdef CURVE_X_X86_DISPATCH
+	__builtin_cpu_init();
+	if ( __builtin_cpu_supports( "avx512f" ) ) return SimdLevel::AVX512;
+	if ( __builtin_cpu_supports( "avx2" ) ) return SimdLevel::AVX2;
+	if ( __builtin_cpu_supports( "sse4.2" ) ) return SimdLevel::SSE42;
+#endif
+
+	return SimdLevel::Scalar;
+}
+
+SimdLevel CurveKernels::get_simd_level()
+{
+	return get_current_level().load( std::memory_order_relaxed );
+}
+
+bool CurveKernels::set_simd_level( SimdLevel level )
+{
+	if ( level > detect_simd_level() ) return false;
+
+	get_current_level().store( level, std::memory_order_relaxed );
+	return true;
+}
+
+const char* CurveKernels::get_simd_level_name( SimdLevel level )
+{
+	switch ( level )
+	{
+		case SimdLevel::Scalar:
+			return "Scalar";
+		case SimdLevel::SSE42:
+			return "SSE4.2";
+		case SimdLevel::AVX2:
+			return "AVX2";
+		case SimdLevel::AVX512:
+			return "AVX-512";
+	}
+
+	return "Unknown";
+}
@@ -0,0 +1,203 @@
+#include <curve-x/curve-loader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+using namespace curve_x;
+
+/*
+ * Returns the milliseconds elapsed since the given time point.
+ */
+static float get_elapsed_time( std::chrono::steady_clock::time_point start )
+{
+	const auto duration = std::chrono::steady_clock::now() - start;
+	return std::chrono::duration<float, std::milli>( duration ).count();
+}
+
+CurveLoader::CurveLoader( int threads_count )
+{
+	if ( threads_count <= 0 )
+	{
+		threads_count = std::max( 1, (int)std::thread::hardware_concurrency() );
+	}
+
+	_threads.reserve( threads_count );
+	for ( int i = 0; i < threads_count; i++ )
+	{
+		_threads.emplace_back( &CurveLoader::_run_worker, this );
+	}
+}
+
+CurveLoader::~CurveLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_is_stopping = true;
+	}
+	_task_condition.notify_all();
+
+	for ( std::thread& thread : _threads )
+	{
+		thread.join();
+	}
+}
+
+std::future<CurveLoadResult> CurveLoader::load( const std::string& path )
+{
+	LoadTask task { path, {} };
+	std::future<CurveLoadResult> future = task.promise.get_future();
+
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		_tasks.push_back( std::move( task ) );
+		_pending_count++;
+	}
+	_task_condition.notify_one();
+
+	return future;
+}
+
+std::vector<std::future<CurveLoadResult>> CurveLoader::load(
+	const std::vector<std::string>& paths
+)
+{
+	std::vector<std::future<CurveLoadResult>> futures;
+	futures.reserve( paths.size() );
+
+	{
+		std::lock_guard<std::mutex> lock( _mutex );
+		for ( const std::string& path : paths )
+		{
+			LoadTask task { path, {} };
+			futures.push_back( task.promise.get_future() );
+			_tasks.push_back( std::move( task ) );
+		}
+		_pending_count += (int)paths.size();
+	}
+	_task_condition.notify_all();
+
+	return futures;
+}
+
+void CurveLoader::wait()
+{
+	std::unique_lock<std::mutex> lock( _mutex );
+	_idle_condition.wait( lock, [this] { return _pending_count == 0; } );
+}
+
+int CurveLoader::get_pending_count() const
+{
+	std::lock_guard<std::mutex> lock( _mutex );
+	return _pending_count;
+}
+
+int CurveLoader::get_threads_count() const
+{
+	return (int)_threads.size();
+}
+
+void CurveLoader::_run_worker()
+{
+	CurveSerializer serializer;
+
+	while ( true )
+	{
+		LoadTask task;
+		{
+			std::unique_lock<std::mutex> lock( _mutex );
+			_task_condition.wait( lock,
+				[this] { return _is_stopping || !_tasks.empty(); } );
+
+			//  Pending loads are finished before stopping
+			if ( _tasks.empty() ) return;
+
+			task = std::move( _tasks.front() );
+			_tasks.pop_front();
+		}
+
+		//  Report exceptions from reading too (e.g. 'std::bad_alloc'),
+		//  so that the promise is always satisfied and counted
+		try
+		{
+			task.promise.set_value( _load_file( task.path, &serializer ) );
+		}
+		catch ( const std::exception& exception )
+		{
+			CurveLoadResult result;
+			result.path = task.path;
+			result.error = exception.what();
+			task.promise.set_value( std::move( result ) );
+		}
+		catch ( ... )
+		{
+			task.promise.set_exception( std::current_exception() );
+		}
+
+		bool is_idle;
+		{
+			std::lock_guard<std::mutex> lock( _mutex );
+			is_idle = --_pending_count == 0;
+		}
+		if ( is_idle ) _idle_condition.notify_all();
+	}
+}
+
+CurveLoadResult CurveLoader::_load_file(
+	const std::string& path,
+	CurveSerializer* serializer
+) const
+{
+	CurveLoadResult result;
+	result.path = path;
+
+	//  Read the whole file
+	auto start = std::chrono::steady_clock::now();
+	std::ifstream file( path, std::ios::binary );
+	if ( !file )
+	{
+		result.error = "Failed to open file!";
+		result.read_time = get_elapsed_time( start );
+		return result;
+	}
+
+	//  Read into a string sized from the file, parsed in place
+	file.seekg( 0, std::ios::end );
+	const std::streamoff size = file.tellg();
+	file.seekg( 0, std::ios::beg );
+
+	std::string data;
+	if ( size > 0 )
+	{
+		data.resize( (size_t)size );
+		file.read( &data[0], size );
+	}
+	if ( size < 0 || !file )
+	{
+		result.error = "Failed to read file!";
+		result.read_time = get_elapsed_time( start );
+		return result;
+	}
+	result.read_time = get_elapsed_time( start );
+
+	if ( data.empty() )
+	{
+		result.error = "Empty file!";
+		return result;
+	}
+
+	//  Parse its data
+	start = std::chrono::steady_clock::now();
+	try
+	{
+		result.curve = serializer->unserialize( data );
+		result.is_loaded = true;
+	}
+	catch ( const std::exception& exception )
+	{
+		result.error = exception.what();
+	}
+	result.parse_time = get_elapsed_time( start );
+
+	return result;
+}
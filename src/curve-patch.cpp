@@ -0,0 +1,379 @@
+#include <curve-x/curve-patch.h>
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace curve_x;
+
+static constexpr uint8_t PATCH_MAGIC[3] { 'C', 'X', 'P' };
+
+static void write_uint32( uint8_t* data, uint32_t value )
+{
+	for ( int i = 0; i < 4; i++ )
+	{
+		data[i] = (uint8_t)( value >> ( i * 8 ) );
+	}
+}
+
+static uint32_t read_uint32( const uint8_t* data )
+{
+	uint32_t value = 0;
+	for ( int i = 0; i < 4; i++ )
+	{
+		value |= (uint32_t)data[i] << ( i * 8 );
+	}
+	return value;
+}
+
+namespace
+{
+	/*
+	 * Cursor reading the operations of a patch, throwing once going
+	 * past the end of the data.
+	 */
+	class PatchReader
+	{
+	public:
+		PatchReader( const uint8_t* data, size_t size )
+			: _data( data ), _end( data + size ) {}
+
+		uint8_t read_byte()
+		{
+			_check_remaining( 1 );
+			return *_data++;
+		}
+		int32_t read_int()
+		{
+			_check_remaining( 4 );
+			const int32_t value = (int32_t)read_uint32( _data );
+			_data += 4;
+			return value;
+		}
+		float read_float()
+		{
+			_check_remaining( 4 );
+			const uint32_t bits = read_uint32( _data );
+			_data += 4;
+
+			float value;
+			memcpy( &value, &bits, sizeof( float ) );
+			return value;
+		}
+		Point read_point()
+		{
+			const float x = read_float();
+			return Point( x, read_float() );
+		}
+
+		bool is_at_end() const
+		{
+			return _data == _end;
+		}
+
+	private:
+		void _check_remaining( size_t size ) const
+		{
+			if ( (size_t)( _end - _data ) < size )
+			{
+				throw std::invalid_argument( "Unexpected end of patch data!" );
+			}
+		}
+
+	private:
+		const uint8_t* _data;
+		const uint8_t* _end;
+	};
+}
+
+/*
+ * Read a mode byte, checking it against the given maximum value.
+ */
+static uint8_t read_mode( PatchReader* reader, uint8_t max_value )
+{
+	const uint8_t value = reader->read_byte();
+	if ( value > max_value )
+	{
+		throw std::invalid_argument( "Invalid mode in patch!" );
+	}
+	return value;
+}
+
+static void check_index( int32_t index, int32_t count )
+{
+	if ( index < 0 || index >= count )
+	{
+		throw std::invalid_argument( "Index out of range in patch!" );
+	}
+}
+
+/*
+ * Read each operation of the given patch, applying them to the
+ * given curve if any. Otherwise, only check the operations, with
+ * the given number of keys.
+ */
+static int read_operations(
+	const uint8_t* data,
+	size_t size,
+	Curve* curve,
+	int keys_count
+)
+{
+	const size_t patch_size = CurvePatch::get_patch_size( data );
+	if ( patch_size != size )
+	{
+		throw std::invalid_argument( "Patch size mismatches its header!" );
+	}
+
+	const int operations_count = (int)read_uint32( data + 8 );
+	PatchReader reader( data + PATCH_HEADER_SIZE, size - PATCH_HEADER_SIZE );
+	for ( int i = 0; i < operations_count; i++ )
+	{
+		const PatchOperation operation = (PatchOperation)reader.read_byte();
+		switch ( operation )
+		{
+			case PatchOperation::SetPoint:
+			{
+				const int32_t point_id = reader.read_int();
+				const Point point = reader.read_point();
+				check_index( point_id, keys_count * 3 );
+
+				if ( curve ) curve->set_point( point_id, point );
+				break;
+			}
+			case PatchOperation::SetTangentPoint:
+			{
+				const int32_t point_id = reader.read_int();
+				const Point point = reader.read_point();
+				const PointSpace point_space = (PointSpace)read_mode(
+					&reader, (uint8_t)PointSpace::Global );
+				check_index( point_id, keys_count * 3 );
+
+				if ( curve ) curve->set_tangent_point( point_id, point, point_space );
+				break;
+			}
+			case PatchOperation::InsertKey:
+			{
+				const int32_t key_id = reader.read_int();
+				const Point control = reader.read_point();
+				const Point left_tangent = reader.read_point();
+				const Point right_tangent = reader.read_point();
+				const TangentMode tangent_mode = (TangentMode)read_mode(
+					&reader, (uint8_t)TangentMode::Broken );
+				const InterpolationMode interpolation_mode =
+					(InterpolationMode)read_mode(
+						&reader, (uint8_t)InterpolationMode::Cubic );
+				check_index( key_id, keys_count + 1 );
+
+				if ( curve )
+				{
+					curve->insert_key( key_id, CurveKey(
+						control,
+						left_tangent,
+						right_tangent,
+						tangent_mode,
+						interpolation_mode
+					) );
+				}
+				keys_count++;
+				break;
+			}
+			case PatchOperation::RemoveKey:
+			{
+				const int32_t key_id = reader.read_int();
+				check_index( key_id, keys_count );
+
+				if ( curve ) curve->remove_key( key_id );
+				keys_count--;
+				break;
+			}
+			case PatchOperation::SetTangentMode:
+			{
+				const int32_t key_id = reader.read_int();
+				const TangentMode mode = (TangentMode)read_mode(
+					&reader, (uint8_t)TangentMode::Broken );
+				const bool should_apply_constraint = read_mode( &reader, 1 ) == 1;
+				check_index( key_id, keys_count );
+
+				if ( curve ) curve->set_tangent_mode( key_id, mode, should_apply_constraint );
+				break;
+			}
+			case PatchOperation::SetInterpolationMode:
+			{
+				const int32_t key_id = reader.read_int();
+				const InterpolationMode mode = (InterpolationMode)read_mode(
+					&reader, (uint8_t)InterpolationMode::Cubic );
+				check_index( key_id, keys_count );
+
+				if ( curve ) curve->set_interpolation_mode( key_id, mode );
+				break;
+			}
+			default:
+				throw std::invalid_argument( "Unknown operation in patch!" );
+		}
+	}
+
+	if ( !reader.is_at_end() )
+	{
+		throw std::invalid_argument( "Unexpected data after patch operations!" );
+	}
+
+	return operations_count;
+}
+
+CurvePatch::CurvePatch()
+{
+	clear();
+}
+
+void CurvePatch::set_point( int point_id, const Point& point )
+{
+	_begin_operation( PatchOperation::SetPoint );
+	_write_int( point_id );
+	_write_point( point );
+	_end_operation();
+}
+
+void CurvePatch::set_tangent_point(
+	int point_id,
+	const Point& point,
+	PointSpace point_space
+)
+{
+	_begin_operation( PatchOperation::SetTangentPoint );
+	_write_int( point_id );
+	_write_point( point );
+	_write_byte( (uint8_t)point_space );
+	_end_operation();
+}
+
+void CurvePatch::insert_key( int key_id, const CurveKey& key )
+{
+	_begin_operation( PatchOperation::InsertKey );
+	_write_int( key_id );
+	_write_point( key.control );
+	_write_point( key.left_tangent );
+	_write_point( key.right_tangent );
+	_write_byte( (uint8_t)key.tangent_mode );
+	_write_byte( (uint8_t)key.interpolation_mode );
+	_end_operation();
+}
+
+void CurvePatch::remove_key( int key_id )
+{
+	_begin_operation( PatchOperation::RemoveKey );
+	_write_int( key_id );
+	_end_operation();
+}
+
+void CurvePatch::set_tangent_mode(
+	int key_id,
+	TangentMode mode,
+	bool should_apply_constraint
+)
+{
+	_begin_operation( PatchOperation::SetTangentMode );
+	_write_int( key_id );
+	_write_byte( (uint8_t)mode );
+	_write_byte( should_apply_constraint ? 1 : 0 );
+	_end_operation();
+}
+
+void CurvePatch::set_interpolation_mode( int key_id, InterpolationMode mode )
+{
+	_begin_operation( PatchOperation::SetInterpolationMode );
+	_write_int( key_id );
+	_write_byte( (uint8_t)mode );
+	_end_operation();
+}
+
+void CurvePatch::clear()
+{
+	_data.assign( PATCH_HEADER_SIZE, 0 );
+	memcpy( _data.data(), PATCH_MAGIC, sizeof( PATCH_MAGIC ) );
+	_data[3] = PATCH_FORMAT_VERSION;
+
+	_operations_count = 0;
+}
+
+const std::vector<uint8_t>& CurvePatch::get_data() const
+{
+	return _data;
+}
+
+int CurvePatch::get_operations_count() const
+{
+	return _operations_count;
+}
+
+void CurvePatch::apply( Curve* curve ) const
+{
+	apply( curve, _data.data(), _data.size() );
+}
+
+int CurvePatch::apply( Curve* curve, const uint8_t* data, size_t size )
+{
+	if ( size < PATCH_HEADER_SIZE )
+	{
+		throw std::invalid_argument( "Expected a patch header!" );
+	}
+
+	//  Check the whole patch first, so that a malformed patch does
+	//  not leave the curve partially edited
+	read_operations( data, size, nullptr, curve->get_keys_count() );
+	return read_operations( data, size, curve, curve->get_keys_count() );
+}
+
+size_t CurvePatch::get_patch_size( const uint8_t* header )
+{
+	if ( memcmp( header, PATCH_MAGIC, sizeof( PATCH_MAGIC ) ) != 0 )
+	{
+		throw std::invalid_argument( "Expected the patch magic!" );
+	}
+	if ( header[3] != PATCH_FORMAT_VERSION )
+	{
+		throw std::invalid_argument( "Unsupported patch format version!" );
+	}
+
+	return PATCH_HEADER_SIZE + read_uint32( header + 4 );
+}
+
+void CurvePatch::_begin_operation( PatchOperation operation )
+{
+	_write_byte( (uint8_t)operation );
+}
+
+void CurvePatch::_end_operation()
+{
+	_operations_count++;
+
+	write_uint32( &_data[4], (uint32_t)( _data.size() - PATCH_HEADER_SIZE ) );
+	write_uint32( &_data[8], (uint32_t)_operations_count );
+}
+
+void CurvePatch::_write_int( int32_t value )
+{
+	const size_t offset = _data.size();
+	_data.resize( offset + 4 );
+	write_uint32( &_data[offset], (uint32_t)value );
+}
+
+void CurvePatch::_write_float( float value )
+{
+	uint32_t bits;
+	memcpy( &bits, &value, sizeof( float ) );
+
+	const size_t offset = _data.size();
+	_data.resize( offset + 4 );
+	write_uint32( &_data[offset], bits );
+}
+
+void CurvePatch::_write_point( const Point& point )
+{
+	_write_float( point.x );
+	_write_float( point.y );
+}
+
+void CurvePatch::_write_byte( uint8_t value )
+{
+	_data.push_back( value );
+}
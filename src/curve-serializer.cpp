@@ -1,10 +1,51 @@
 #include <curve-x/curve-serializer.h>
 
+#include <algorithm>
+#include <cstring>
 #include <regex>
 #include <sstream>
 
 using namespace curve_x;
 
+/*
+ * Parse a number at the given string into the given value and 
+ * returns the character following it, or a null pointer if there 
+ * is no number.
+ * 
+ * Unlike 'strtof' and 'strtol' alone, leading whitespaces are not
+ * skipped, so the parsing never goes past the end of a line.
+ */
+static const char* parse_float( const char* str, float* value )
+{
+	if ( !( isdigit( (unsigned char)*str ) || *str == '-' || *str == '.' ) ) return nullptr;
+
+	char* str_end;
+	*value = strtof( str, &str_end );
+	return str_end == str ? nullptr : str_end;
+}
+
+static const char* parse_int( const char* str, int* value )
+{
+	if ( !( isdigit( (unsigned char)*str ) || *str == '-' ) ) return nullptr;
+
+	char* str_end;
+	*value = (int)strtol( str, &str_end, 10 );
+	return str_end == str ? nullptr : str_end;
+}
+
+/*
+ * Parse a point formatted as 'x=<x>;y=<y>' at the given string.
+ */
+static const char* parse_point( const char* str, const char* end, Point* point )
+{
+	if ( end - str < 2 || strncmp( str, "x=", 2 ) != 0 ) return nullptr;
+	str = parse_float( str + 2, &point->x );
+
+	if ( str == nullptr || end - str < 3 || strncmp( str, ";y=", 3 ) != 0 ) 
+		return nullptr;
+	return parse_float( str + 3, &point->y );
+}
+
 CurveSerializer::CurveSerializer()
 {
 }
@@ -25,22 +66,173 @@ std::string CurveSerializer::serialize( const Curve& curve )
 		stream << key.control.str() << ',';
 		stream << key.left_tangent.str() << ',';
 		stream << key.right_tangent.str() << ',';
-		stream << (int)key.tangent_mode << '\n';
+		stream << (int)key.tangent_mode << ',';
+		stream << (int)key.interpolation_mode << '\n';
+	}
+
+	return stream.str();
+}
+
+Curve CurveSerializer::unserialize( 
+	const std::string& data,
+	std::pmr::memory_resource* resource
+)
+{
+	int version = -1;
+	Curve curve( resource );
+
+	//  Reserve a key per line, avoiding reallocations while parsing
+	curve.reserve( (int)std::count( data.begin(), data.end(), '\n' ) );
+
+	//  Read data line per line, in place
+	const char* begin = data.c_str();
+	const char* end = begin + data.size();
+	while ( begin < end )
+	{
+		const char* line_end = std::find( begin, end, '\n' );
+
+		CurveKey key( Point( 0.0f, 0.0f ) );
+		if ( _parse_line( begin, line_end, &version, &key ) )
+		{
+			curve.add_key( key );
+		}
+
+		begin = line_end + 1;
+	}
+
+	return curve;
+}
+
+Curve CurveSerializer::unserialize( 
+	std::istream& stream,
+	std::pmr::memory_resource* resource
+)
+{
+	Curve curve( resource );
+	unserialize( stream, 
+		[&curve]( const CurveKey& key ) {
+			curve.add_key( key );
+		}
+	);
+
+	return curve;
+}
+
+int CurveSerializer::unserialize( 
+	std::istream& stream,
+	const std::function<void( const CurveKey& key )>& callback
+)
+{
+	int version = -1;
+	int keys_count = 0;
+
+	std::vector<char> chunk( UNSERIALIZE_CHUNK_SIZE );
+	//  Line split between two chunks, only growing to the length
+	//  of the longest line
+	std::string partial_line;
+
+	auto parse_line = [&]( const char* begin, const char* end ) {
+		CurveKey key( Point( 0.0f, 0.0f ) );
+		if ( _parse_line( begin, end, &version, &key ) )
+		{
+			callback( key );
+			keys_count++;
+		}
+	};
+
+	while ( stream.read( chunk.data(), chunk.size() ) || stream.gcount() > 0 )
+	{
+		const char* begin = chunk.data();
+		const char* end = begin + stream.gcount();
+		while ( begin < end )
+		{
+			const char* line_end = std::find( begin, end, '\n' );
+			if ( line_end == end )
+			{
+				partial_line.append( begin, end );
+				break;
+			}
+
+			if ( partial_line.empty() )
+			{
+				parse_line( begin, line_end );
+			}
+			else
+			{
+				partial_line.append( begin, line_end );
+				parse_line( 
+					partial_line.c_str(), 
+					partial_line.c_str() + partial_line.size() 
+				);
+				partial_line.clear();
+			}
+
+			begin = line_end + 1;
+		}
+	}
+
+	//  Parse the last line, not ending with a new line
+	if ( !partial_line.empty() )
+	{
+		parse_line( 
+			partial_line.c_str(), 
+			partial_line.c_str() + partial_line.size() 
+		);
+	}
+
+	return keys_count;
+}
+
+std::string CurveSerializer::serialize( const MultiCurve& curve )
+{
+	std::stringstream stream;
+
+	//  Append library version & channels count
+	stream << "version:" << FORMAT_VERSION << '\n';
+	stream << "channels:" << curve.get_channels_count() << '\n';
+
+	//  Append keys
+	int keys_count = curve.get_keys_count();
+	int channels_count = curve.get_channels_count();
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		stream << key_id << ':';
+		stream << "x=" << std::to_string( curve.get_key_time( key_id ) );
+		stream << ',' << (int)curve.get_tangent_mode( key_id );
+		stream << ',' << (int)curve.get_interpolation_mode( key_id );
+
+		for ( int channel = 0; channel < channels_count; channel++ )
+		{
+			float value = curve.get_value( key_id, channel );
+			stream << '|';
+			stream << "y=" << std::to_string( value ) << ',';
+			stream << curve.get_left_tangent( key_id, channel ).str() << ',';
+			stream << curve.get_right_tangent( key_id, channel ).str();
+		}
+
+		stream << '\n';
 	}
 
 	return stream.str();
 }
 
-Curve CurveSerializer::unserialize( const std::string& data )
+MultiCurve CurveSerializer::unserialize_multi( const std::string& data )
 {
 	int version = -1;
-	std::vector<CurveKey> keys;
+	int channels_count = -1;
+	MultiCurve curve;
+
+	std::vector<float> values;
+	std::vector<Point> left_tangents;
+	std::vector<Point> right_tangents;
 
 	//  Regexes
 	std::regex REGEX_VERSION( "version:(\\d+)" );
+	std::regex REGEX_CHANNELS( "channels:(\\d+)" );
 	std::regex REGEX_KEY_ID( "(\\d+):" );
+	std::regex REGEX_TIME( "x=(\\-?\\d+\\.\\d+),(\\d+)(?:,(\\d+))?" );
+	std::regex REGEX_VALUE( "\\|y=(\\-?\\d+\\.\\d+)" );
 	std::regex REGEX_POINT( "x=(\\-?\\d+\\.\\d+);y=(\\-?\\d+\\.\\d+)" );
-	std::regex REGEX_NUMBER( "\\-?(\\d+)" );
 
 	//  Read data line per line
 	std::istringstream iss( data );
@@ -58,11 +250,25 @@ Curve CurveSerializer::unserialize( const std::string& data )
 				);
 			}
 
-			//  Convert string to integer
 			version = _to_int( match[1].str() );
+			continue;
+		}
 
-			//  TODO: Take in account older versions
+		//  Find channels count
+		if ( channels_count == -1 )
+		{
+			if ( !std::regex_match( line, match, REGEX_CHANNELS ) )
+			{
+				throw std::invalid_argument( 
+					"Expected channels count at the second line!" 
+				);
+			}
 
+			channels_count = _to_int( match[1].str() );
+			curve = MultiCurve( channels_count );
+			values.resize( channels_count );
+			left_tangents.resize( channels_count );
+			right_tangents.resize( channels_count );
 			continue;
 		}
 
@@ -71,38 +277,162 @@ Curve CurveSerializer::unserialize( const std::string& data )
 		{
 			line = match.suffix().str();
 
-			//  Match control point
-			std::regex_search( line, match, REGEX_POINT );
-			Point control = _to_point( match[1], match[2] );
+			//  Match time & tangent mode
+			if ( !std::regex_search( line, match, REGEX_TIME ) )
+			{
+				throw std::invalid_argument( 
+					"Expected a key time and tangent mode!" 
+				);
+			}
+			float time = _to_float( match[1] );
+			int mode_id = _to_int( match[2] );
+			if ( mode_id >= (int)TangentMode::MAX )
+			{
+				throw std::invalid_argument( "Invalid key tangent mode!" );
+			}
+			TangentMode tangent_mode = (TangentMode)mode_id;
+			//  Interpolation modes were added in version 2
+			InterpolationMode interpolation_mode = InterpolationMode::Cubic;
+			if ( version >= 2 && match[3].matched )
+			{
+				mode_id = _to_int( match[3] );
+				if ( mode_id >= (int)InterpolationMode::MAX )
+				{
+					throw std::invalid_argument( 
+						"Invalid key interpolation mode!" 
+					);
+				}
+				interpolation_mode = (InterpolationMode)mode_id;
+			}
 			line = match.suffix().str();
 
-			//  Match left tangent point
-			std::regex_search( line, match, REGEX_POINT );
-			Point left_tangent = _to_point( match[1], match[2] );
-			line = match.suffix().str();
+			//  Match channels
+			for ( int channel = 0; channel < channels_count; channel++ )
+			{
+				if ( !std::regex_search( line, match, REGEX_VALUE ) )
+				{
+					throw std::invalid_argument( 
+						"Expected a value for each channel!" 
+					);
+				}
+				values[channel] = _to_float( match[1] );
+				line = match.suffix().str();
 
-			//  Match right tangent point
-			std::regex_search( line, match, REGEX_POINT );
-			Point right_tangent = _to_point( match[1], match[2] );
-			line = match.suffix().str();
+				if ( !std::regex_search( line, match, REGEX_POINT ) )
+				{
+					throw std::invalid_argument( 
+						"Expected a left tangent for each channel!" 
+					);
+				}
+				left_tangents[channel] = _to_point( match[1], match[2] );
+				line = match.suffix().str();
 
-			//  Match tangent mode
-			std::regex_search( line, match, REGEX_NUMBER );
-			int mode_id = _to_int( match[1] );
-			TangentMode tangent_mode = (TangentMode)mode_id;
-			line = match.suffix().str();
+				if ( !std::regex_search( line, match, REGEX_POINT ) )
+				{
+					throw std::invalid_argument( 
+						"Expected a right tangent for each channel!" 
+					);
+				}
+				right_tangents[channel] = _to_point( match[1], match[2] );
+				line = match.suffix().str();
+			}
 
 			//  Create key
-			keys.emplace_back(
-				control, 
-				left_tangent, 
-				right_tangent, 
-				tangent_mode 
+			curve.add_key(
+				time,
+				values.data(),
+				left_tangents.data(),
+				right_tangents.data(),
+				tangent_mode,
+				interpolation_mode
+			);
+		}
+	}
+
+	return curve;
+}
+
+bool CurveSerializer::_parse_line( 
+	const char* begin, 
+	const char* end, 
+	int* version, 
+	CurveKey* key 
+)
+{
+	//  Find format version
+	if ( *version == -1 )
+	{
+		constexpr size_t PREFIX_LENGTH = sizeof( "version:" ) - 1;
+
+		const char* str = nullptr;
+		if ( (size_t)( end - begin ) > PREFIX_LENGTH
+		  && strncmp( begin, "version:", PREFIX_LENGTH ) == 0 )
+		{
+			str = parse_int( begin + PREFIX_LENGTH, version );
+		}
+
+		//  Allow Windows line endings
+		if ( str != nullptr && str < end && *str == '\r' ) str++;
+		if ( str != end || *version < 0 )
+		{
+			throw std::invalid_argument( 
+				"Expected format version at the first line!" 
+			);
+		}
+
+		return false;
+	}
+
+	//  Skip lines not starting with a key ID
+	const char* str = begin;
+	while ( str < end && isdigit( (unsigned char)*str ) ) str++;
+	if ( str == begin || str == end || *str != ':' ) return false;
+	str++;
+
+	//  Match control point & tangents
+	Point* points[3] { &key->control, &key->left_tangent, &key->right_tangent };
+	for ( Point* point : points )
+	{
+		str = parse_point( str, end, point );
+		if ( str == nullptr || str == end || *str != ',' )
+		{
+			throw std::invalid_argument( "Expected a key point!" );
+		}
+		str++;
+	}
+
+	//  Match tangent mode
+	int mode_id;
+	str = parse_int( str, &mode_id );
+	if ( str == nullptr )
+	{
+		throw std::invalid_argument( "Expected a key tangent mode!" );
+	}
+	key->tangent_mode = (TangentMode)mode_id;
+
+	//  Match interpolation mode, introduced in version 2
+	key->interpolation_mode = InterpolationMode::Cubic;
+	if ( *version >= 2 )
+	{
+		if ( str != end && *str == ',' )
+		{
+			str = parse_int( str + 1, &mode_id );
+		}
+		else
+		{
+			str = nullptr;
+		}
+
+		if ( str == nullptr )
+		{
+			throw std::invalid_argument( 
+				"Expected a key interpolation mode!" 
 			);
 		}
+		key->interpolation_mode = (InterpolationMode)mode_id;
 	}
 
-	return Curve( keys );
+	return true;
 }
 
 int CurveSerializer::_to_int( const std::string& str )
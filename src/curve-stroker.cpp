@@ -0,0 +1,356 @@
+#include <curve-x/curve-stroker.h>
+
+#include <cstring>
+
+using namespace curve_x;
+
+/*
+ * Maximum number of times a segment is split while flattened.
+ */
+static constexpr int MAX_FLATTENING_DEPTH = 12;
+
+static constexpr float PI = 3.14159265358979323846f;
+
+static float dot( const Point& a, const Point& b )
+{
+	return a.x * b.x + a.y * b.y;
+}
+
+static float cross( const Point& a, const Point& b )
+{
+	return a.x * b.y - a.y * b.x;
+}
+
+/*
+ * Returns the absolute angle, in radians, between both given
+ * vectors. A null vector forms no angle.
+ */
+static float compute_angle( const Point& a, const Point& b )
+{
+	return atan2f( fabsf( cross( a, b ) ), dot( a, b ) );
+}
+
+CurveStroker::CurveStroker(
+	float width,
+	StrokeJoin join,
+	float tolerance
+)
+	: _width( width ), _join( join ), _tolerance( tolerance )
+{
+	_update_max_angle();
+}
+
+int CurveStroker::stroke( const Curve& curve, Point* vertices, int capacity )
+{
+	const std::vector<Point>& stroke_vertices = stroke( curve );
+
+	const int count = (int)stroke_vertices.size();
+	if ( count <= capacity )
+	{
+		memcpy( vertices, stroke_vertices.data(), count * sizeof( Point ) );
+	}
+
+	return count;
+}
+
+const std::vector<Point>& CurveStroker::stroke( const Curve& curve )
+{
+	CachedStroke& cached_stroke = _strokes[&curve];
+
+	//  Revisions are unique, so that a curve reusing the address
+	//  of a destroyed one is tessellated again
+	const uint64_t revision = curve.get_revision();
+	if ( cached_stroke.revision != revision )
+	{
+		_flatten( curve );
+		_tessellate( &cached_stroke.vertices );
+
+		cached_stroke.revision = revision;
+	}
+
+	return cached_stroke.vertices;
+}
+
+void CurveStroker::forget( const Curve& curve )
+{
+	_strokes.erase( &curve );
+}
+
+void CurveStroker::clear_cache()
+{
+	_strokes.clear();
+}
+
+int CurveStroker::get_cached_strokes_count() const
+{
+	return (int)_strokes.size();
+}
+
+void CurveStroker::set_width( float width )
+{
+	if ( width == _width ) return;
+
+	_width = width;
+	_update_max_angle();
+	clear_cache();
+}
+
+void CurveStroker::set_join( StrokeJoin join )
+{
+	if ( join == _join ) return;
+
+	_join = join;
+	clear_cache();
+}
+
+void CurveStroker::set_miter_limit( float miter_limit )
+{
+	if ( miter_limit == _miter_limit ) return;
+
+	_miter_limit = miter_limit;
+	clear_cache();
+}
+
+void CurveStroker::set_tolerance( float tolerance )
+{
+	if ( tolerance == _tolerance ) return;
+
+	_tolerance = tolerance;
+	_update_max_angle();
+	clear_cache();
+}
+
+float CurveStroker::get_width() const
+{
+	return _width;
+}
+
+StrokeJoin CurveStroker::get_join() const
+{
+	return _join;
+}
+
+float CurveStroker::get_miter_limit() const
+{
+	return _miter_limit;
+}
+
+float CurveStroker::get_tolerance() const
+{
+	return _tolerance;
+}
+
+void CurveStroker::_update_max_angle()
+{
+	const float half_width = _width * 0.5f;
+	if ( _tolerance >= half_width )
+	{
+		_max_angle = PI;
+		return;
+	}
+
+	//  An arc of the edges deviates from its chord by
+	//  'half_width * ( 1 - cos( angle / 2 ) )'
+	_max_angle = 2.0f * acosf( 1.0f - _tolerance / half_width );
+}
+
+void CurveStroker::_flatten( const Curve& curve )
+{
+	_polyline.clear();
+	if ( !curve.is_valid() ) return;
+
+	_polyline.push_back( curve.get_key( 0 ).control );
+	for ( int curve_id = 0; curve_id < curve.get_curves_count(); curve_id++ )
+	{
+		const CurveKey& k0 = curve.get_key( curve_id );
+		const CurveKey& k1 = curve.get_key( curve_id + 1 );
+
+		const Point& p0 = k0.control;
+		const Point& p3 = k1.control;
+
+		switch ( k0.interpolation_mode )
+		{
+			case InterpolationMode::Constant:
+				_add_point( Point( p3.x, p0.y ) );
+				_add_point( p3 );
+				break;
+			case InterpolationMode::Linear:
+				_add_point( p3 );
+				break;
+			default:
+				_flatten_segment(
+					p0, p0 + k0.right_tangent,
+					p3 + k1.left_tangent, p3,
+					0
+				);
+				break;
+		}
+	}
+}
+
+void CurveStroker::_flatten_segment(
+	const Point& p0, const Point& p1,
+	const Point& p2, const Point& p3,
+	int depth
+)
+{
+	if ( depth < MAX_FLATTENING_DEPTH )
+	{
+		//  Distance of the tangent points to the chord, bounding
+		//  the distance of the segment to the chord
+		const Point chord = p3 - p0;
+		const float chord_length_sqr = chord.length_sqr();
+
+		float distance_sqr;
+		if ( chord_length_sqr > 0.0f )
+		{
+			const float d1 = cross( p1 - p0, chord );
+			const float d2 = cross( p2 - p0, chord );
+			distance_sqr = fmaxf( d1 * d1, d2 * d2 ) / chord_length_sqr;
+		}
+		else
+		{
+			distance_sqr = fmaxf(
+				( p1 - p0 ).length_sqr(),
+				( p2 - p0 ).length_sqr()
+			);
+		}
+
+		//  Turning of the control polygon, bounding the turning of
+		//  the segment
+		const float angle =
+			compute_angle( p1 - p0, p2 - p1 )
+		  + compute_angle( p2 - p1, p3 - p2 );
+
+		if ( distance_sqr > _tolerance * _tolerance || angle > _max_angle )
+		{
+			//  Split in half with De Casteljau's algorithm
+			const Point p01 = ( p0 + p1 ) * 0.5f;
+			const Point p12 = ( p1 + p2 ) * 0.5f;
+			const Point p23 = ( p2 + p3 ) * 0.5f;
+			const Point p012 = ( p01 + p12 ) * 0.5f;
+			const Point p123 = ( p12 + p23 ) * 0.5f;
+			const Point middle = ( p012 + p123 ) * 0.5f;
+
+			_flatten_segment( p0, p01, p012, middle, depth + 1 );
+			_flatten_segment( middle, p123, p23, p3, depth + 1 );
+			return;
+		}
+	}
+
+	_add_point( p3 );
+}
+
+void CurveStroker::_add_point( const Point& point )
+{
+	if ( point == _polyline.back() ) return;
+
+	_polyline.push_back( point );
+}
+
+void CurveStroker::_tessellate( std::vector<Point>* vertices ) const
+{
+	vertices->clear();
+
+	const int count = (int)_polyline.size();
+	if ( count < 2 ) return;
+
+	vertices->reserve( count * 2 );
+
+	Point in_direction = ( _polyline[1] - _polyline[0] ).normalized();
+	for ( int point_id = 0; point_id < count; point_id++ )
+	{
+		//  Ends continue the direction of their only neighbour
+		Point out_direction = in_direction;
+		if ( point_id + 1 < count )
+		{
+			out_direction = ( _polyline[point_id + 1]
+				- _polyline[point_id] ).normalized();
+		}
+
+		_add_join( _polyline[point_id], in_direction, out_direction,
+			vertices );
+		in_direction = out_direction;
+	}
+}
+
+void CurveStroker::_add_join(
+	const Point& point,
+	const Point& in_direction,
+	const Point& out_direction,
+	std::vector<Point>* vertices
+) const
+{
+	const float half_width = _width * 0.5f;
+
+	const Point in_normal( -in_direction.y, in_direction.x );
+	const Point out_normal( -out_direction.y, out_direction.x );
+
+	//  Direction and distance from the point to the corners of
+	//  the edges, undefined on a U-turn
+	Point miter = in_normal + out_normal;
+	float miter_length = INFINITY;
+
+	const float miter_length_sqr = miter.length_sqr();
+	if ( miter_length_sqr > 1e-12f )
+	{
+		miter = miter / sqrtf( miter_length_sqr );
+		miter_length = half_width / dot( miter, in_normal );
+	}
+
+	const float turn = cross( in_direction, out_direction );
+	const float angle = atan2f( fabsf( turn ), dot( in_direction, out_direction ) );
+
+	const bool is_miter = _join == StrokeJoin::Miter
+		? miter_length <= _miter_limit * half_width
+		: angle <= _max_angle && miter_length_sqr > 1e-12f;
+	if ( is_miter )
+	{
+		vertices->push_back( point + miter * miter_length );
+		vertices->push_back( point - miter * miter_length );
+		return;
+	}
+
+	//  The outer edge is on the left when turning right
+	const float side = turn > 0.0f ? -1.0f : 1.0f;
+
+	Point inner = point;
+	if ( miter_length_sqr > 1e-12f )
+	{
+		inner = point - miter * ( side
+			* fminf( miter_length, _miter_limit * half_width ) );
+	}
+
+	//  Fan around the inner corner, from the incoming outer edge
+	//  to the outgoing one, in a single step for a bevel
+	int steps_count = 1;
+	if ( _join == StrokeJoin::Round )
+	{
+		steps_count = (int)ceilf( angle / _max_angle );
+	}
+
+	const float step_angle = ( turn > 0.0f ? angle : -angle ) / steps_count;
+	const float step_cos = cosf( step_angle );
+	const float step_sin = sinf( step_angle );
+
+	Point normal = in_normal * side;
+	for ( int step = 0; step <= steps_count; step++ )
+	{
+		const Point outer = point + normal * half_width;
+		if ( side > 0.0f )
+		{
+			vertices->push_back( outer );
+			vertices->push_back( inner );
+		}
+		else
+		{
+			vertices->push_back( inner );
+			vertices->push_back( outer );
+		}
+
+		normal = Point(
+			normal.x * step_cos - normal.y * step_sin,
+			normal.x * step_sin + normal.y * step_cos
+		);
+	}
+}
@@ -0,0 +1,343 @@
+#include <curve-x/curve-track-scheduler.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+using namespace curve_x;
+
+CurveTrackScheduler::CurveTrackScheduler()
+{}
+
+CurveTrackScheduler::~CurveTrackScheduler()
+{
+	{
+		std::lock_guard<std::mutex> lock( _workers_mutex );
+		_is_stopping = true;
+	}
+	_tick_condition.notify_all();
+
+	for ( std::thread& worker : _workers )
+	{
+		worker.join();
+	}
+}
+
+int CurveTrackScheduler::add_track(
+	const CompiledCurve* curve,
+	float time,
+	float speed,
+	TrackWrapMode wrap_mode
+)
+{
+	assert( curve != nullptr && curve->is_valid() );
+
+	//  Reuse the index of a removed track
+	int track_id;
+	if ( !_free_track_ids.empty() )
+	{
+		track_id = _free_track_ids.back();
+		_free_track_ids.pop_back();
+	}
+	else
+	{
+		track_id = (int)_slots.size();
+		_slots.push_back( -1 );
+	}
+
+	_slots[track_id] = (int)_curves.size();
+	_curves.push_back( curve );
+	_times.push_back( time );
+	_speeds.push_back( speed );
+	_wrap_modes.push_back( wrap_mode );
+	_track_ids.push_back( track_id );
+
+	//  Keep sorted when appending to the last group
+	if ( _curves.size() > 1 && _curves[_curves.size() - 2] != curve )
+	{
+		_is_sorted = false;
+	}
+
+	return track_id;
+}
+
+void CurveTrackScheduler::remove_track( int track_id )
+{
+	assert( is_valid_track( track_id ) );
+
+	//  Move the last slot into the removed one
+	const int slot = _slots[track_id];
+	const int last_slot = (int)_curves.size() - 1;
+	if ( slot != last_slot )
+	{
+		_curves[slot] = _curves[last_slot];
+		_times[slot] = _times[last_slot];
+		_speeds[slot] = _speeds[last_slot];
+		_wrap_modes[slot] = _wrap_modes[last_slot];
+		_track_ids[slot] = _track_ids[last_slot];
+		_slots[_track_ids[slot]] = slot;
+
+		_is_sorted = false;
+	}
+
+	_curves.pop_back();
+	_times.pop_back();
+	_speeds.pop_back();
+	_wrap_modes.pop_back();
+	_track_ids.pop_back();
+
+	_slots[track_id] = -1;
+	_free_track_ids.push_back( track_id );
+}
+
+void CurveTrackScheduler::clear()
+{
+	_curves.clear();
+	_times.clear();
+	_speeds.clear();
+	_wrap_modes.clear();
+	_track_ids.clear();
+	_slots.clear();
+	_free_track_ids.clear();
+
+	_is_sorted = true;
+}
+
+void CurveTrackScheduler::advance(
+	float delta_time,
+	float* values,
+	int threads_count
+)
+{
+	_sort_tracks();
+	_advance_slots( delta_time, values, threads_count );
+}
+
+void CurveTrackScheduler::evaluate( float* values, int threads_count )
+{
+	_sort_tracks();
+	_advance_slots( 0.0f, values, threads_count );
+}
+
+void CurveTrackScheduler::set_track_time( int track_id, float time )
+{
+	assert( is_valid_track( track_id ) );
+	_times[_slots[track_id]] = time;
+}
+
+float CurveTrackScheduler::get_track_time( int track_id ) const
+{
+	assert( is_valid_track( track_id ) );
+	return _times[_slots[track_id]];
+}
+
+void CurveTrackScheduler::set_track_speed( int track_id, float speed )
+{
+	assert( is_valid_track( track_id ) );
+	_speeds[_slots[track_id]] = speed;
+}
+
+bool CurveTrackScheduler::is_track_finished( int track_id ) const
+{
+	assert( is_valid_track( track_id ) );
+
+	const int slot = _slots[track_id];
+	if ( _wrap_modes[slot] != TrackWrapMode::Clamp ) return false;
+
+	const CompiledCurve& curve = *_curves[slot];
+	const float duration = curve.get_key_time( curve.get_keys_count() - 1 )
+						 - curve.get_key_time( 0 );
+	return _times[slot] >= duration;
+}
+
+bool CurveTrackScheduler::is_valid_track( int track_id ) const
+{
+	return track_id >= 0
+		&& track_id < (int)_slots.size()
+		&& _slots[track_id] != -1;
+}
+
+int CurveTrackScheduler::get_tracks_count() const
+{
+	return (int)_curves.size();
+}
+
+int CurveTrackScheduler::get_tracks_capacity() const
+{
+	return (int)_slots.size();
+}
+
+void CurveTrackScheduler::_sort_tracks()
+{
+	if ( _is_sorted ) return;
+
+	//  Find the sorted order of the slots
+	const int tracks_count = get_tracks_count();
+	std::vector<int> order( tracks_count );
+	std::iota( order.begin(), order.end(), 0 );
+	std::stable_sort( order.begin(), order.end(),
+		[this]( int a, int b ) {
+			return std::less<const CompiledCurve*>()( _curves[a], _curves[b] );
+		}
+	);
+
+	//  Apply the order to each array
+	auto reorder = [&order, tracks_count]( auto& array ) {
+		std::remove_reference_t<decltype( array )> sorted_array;
+		sorted_array.reserve( tracks_count );
+		for ( int slot : order )
+		{
+			sorted_array.push_back( array[slot] );
+		}
+		array.swap( sorted_array );
+	};
+	reorder( _curves );
+	reorder( _times );
+	reorder( _speeds );
+	reorder( _wrap_modes );
+	reorder( _track_ids );
+
+	for ( int slot = 0; slot < tracks_count; slot++ )
+	{
+		_slots[_track_ids[slot]] = slot;
+	}
+
+	_is_sorted = true;
+}
+
+void CurveTrackScheduler::_advance_range(
+	int first_slot,
+	int last_slot,
+	float delta_time,
+	float* values
+)
+{
+	int slot = first_slot;
+	while ( slot < last_slot )
+	{
+		//  Evaluate the tracks of a same curve together
+		const CompiledCurve& curve = *_curves[slot];
+		const float start_time = curve.get_key_time( 0 );
+		const float duration = curve.get_key_time( curve.get_keys_count() - 1 )
+							 - start_time;
+
+		for ( ; slot < last_slot && _curves[slot] == &curve; slot++ )
+		{
+			const bool is_started = _times[slot] >= 0.0f;
+			float time = _times[slot] + delta_time * _speeds[slot];
+			float local_time = time;
+
+			//  Wrap the stored time to keep its precision, negative
+			//  times being delays until the track has started, after
+			//  which they come from negative speeds
+			switch ( _wrap_modes[slot] )
+			{
+				case TrackWrapMode::Clamp:
+					time = fminf( time, duration );
+					local_time = time;
+					break;
+				case TrackWrapMode::Loop:
+					if ( duration > 0.0f 
+					  && ( time >= duration || ( time < 0.0f && is_started ) ) )
+					{
+						time = fmodf( time, duration );
+						if ( time < 0.0f ) time += duration;
+					}
+					local_time = time;
+					break;
+				case TrackWrapMode::PingPong:
+					if ( duration > 0.0f 
+					  && ( time >= 2.0f * duration || ( time < 0.0f && is_started ) ) )
+					{
+						time = fmodf( time, 2.0f * duration );
+						if ( time < 0.0f ) time += 2.0f * duration;
+					}
+					local_time = time > duration ? 2.0f * duration - time : time;
+					break;
+			}
+
+			_times[slot] = time;
+			values[_track_ids[slot]] = curve.evaluate_by_time(
+				start_time + local_time );
+		}
+	}
+}
+
+void CurveTrackScheduler::_advance_slots(
+	float delta_time,
+	float* values,
+	int threads_count
+)
+{
+	const int tracks_count = get_tracks_count();
+	threads_count = std::min( threads_count, tracks_count / TRACKS_PER_THREAD_MIN );
+	if ( threads_count <= 1 )
+	{
+		_advance_range( 0, tracks_count, delta_time, values );
+		return;
+	}
+
+	//  Start the missing workers, kept for the next ticks
+	while ( (int)_workers.size() < threads_count - 1 )
+	{
+		_workers.emplace_back( &CurveTrackScheduler::_run_worker, this,
+			(int)_workers.size() );
+	}
+
+	//  Split slots in contiguous ranges, the last one being run on
+	//  the calling thread
+	const int tracks_per_thread = tracks_count / threads_count;
+	{
+		std::lock_guard<std::mutex> lock( _workers_mutex );
+		_tick_id++;
+		_tick_threads_count = threads_count;
+		_tick_tracks_per_thread = tracks_per_thread;
+		_tick_delta_time = delta_time;
+		_tick_values = values;
+		_pending_workers_count = threads_count - 1;
+	}
+	_tick_condition.notify_all();
+
+	_advance_range(
+		( threads_count - 1 ) * tracks_per_thread, tracks_count,
+		delta_time, values
+	);
+
+	std::unique_lock<std::mutex> lock( _workers_mutex );
+	_done_condition.wait( lock, [this]() {
+		return _pending_workers_count == 0;
+	} );
+}
+
+void CurveTrackScheduler::_run_worker( int worker_id )
+{
+	uint64_t last_tick_id = 0;
+
+	std::unique_lock<std::mutex> lock( _workers_mutex );
+	while ( true )
+	{
+		_tick_condition.wait( lock, [this, last_tick_id]() {
+			return _is_stopping || _tick_id != last_tick_id;
+		} );
+		if ( _is_stopping ) return;
+
+		last_tick_id = _tick_id;
+
+		//  Workers beyond the threads count of this tick are idle
+		if ( worker_id >= _tick_threads_count - 1 ) continue;
+
+		const int first_slot = worker_id * _tick_tracks_per_thread;
+		const int last_slot = first_slot + _tick_tracks_per_thread;
+		const float delta_time = _tick_delta_time;
+		float* values = _tick_values;
+
+		lock.unlock();
+		_advance_range( first_slot, last_slot, delta_time, values );
+		lock.lock();
+
+		if ( --_pending_workers_count == 0 )
+		{
+			_done_condition.notify_one();
+		}
+	}
+}
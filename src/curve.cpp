@@ -1,88 +1,344 @@
 #include <curve-x/curve.h>
+#include <curve-x/compiled-curve.h>
+
+//  Compile the hot paths here, unless inlined by 'curve.h'
+#define CURVE_X_COMPILING_HOT_PATHS
+#include <curve-x/curve-inline.h>
+
+#include <atomic>
 
 using namespace curve_x;
 
+/*
+ * Number of samples per original segment used to measure the
+ * deviation of a simplified segment.
+ */
+static constexpr int SIMPLIFICATION_SAMPLES_COUNT = 16;
+
+/*
+ * Returns a new curve revision, unique among all curves.
+ */
+static uint64_t generate_revision()
+{
+	static std::atomic<uint64_t> last_revision { 0 };
+	return ++last_revision;
+}
+
+/*
+ * Fill given variables with the four Bézier points formed by two
+ * keys, see 'Curve::get_segment_points'.
+ */
+static void compute_segment_points( 
+	const CurveKey& k0, 
+	const CurveKey& k1, 
+	Point* p0, Point* p1, 
+	Point* p2, Point* p3 
+)
+{
+	*p0 = k0.control;
+	*p3 = k1.control;
+
+	switch ( k0.interpolation_mode )
+	{
+		case InterpolationMode::Constant:
+			*p1 = *p2 = *p3 = k0.control;
+			break;
+		case InterpolationMode::Linear:
+			*p1 = k0.control + ( k1.control - k0.control ) / 3.0f;
+			*p2 = k1.control + ( k0.control - k1.control ) / 3.0f;
+			break;
+		default:
+			*p1 = k0.control + k0.right_tangent;
+			*p2 = k1.control + k1.left_tangent;
+			break;
+	}
+}
+
 Curve::Curve()
 {}
 
-Curve::Curve( const std::vector<CurveKey>& keys )
-	: _keys( keys )
+Curve::Curve( std::pmr::memory_resource* resource )
+	: _keys( resource ),
+	  _segments_cache( resource ),
+	  _prefix_integrals( resource )
 {}
 
-Point Curve::evaluate_by_percent( float t ) const
+Curve::Curve( 
+	const std::vector<CurveKey>& keys,
+	std::pmr::memory_resource* resource
+)
+	: _keys( keys.begin(), keys.end(), resource ),
+	  _segments_cache( resource ),
+	  _prefix_integrals( resource )
+{}
+
+Curve::Curve( std::pmr::vector<CurveKey>&& keys )
+	: _keys( std::move( keys ) ),
+	  _segments_cache( _keys.get_allocator().resource() ),
+	  _prefix_integrals( _keys.get_allocator().resource() )
+{}
+
+Point Curve::evaluate_derivative_by_percent( float t ) const
 {
-	int first_key_id, last_key_id;
-	find_evaluation_keys_id_by_percent( 
-		&first_key_id, &last_key_id, t );
-	//t = fmaxf( fminf( t, 1.0f ), 0.0f );
+	Point points[2];
+	_evaluate_by_percent( t, points, 1 );
+	return points[1];
+}
 
-	const CurveKey& k0 = get_key( first_key_id );
-	const CurveKey& k1 = get_key( last_key_id );
+Point Curve::evaluate_second_derivative_by_percent( float t ) const
+{
+	Point points[3];
+	_evaluate_by_percent( t, points, 2 );
+	return points[2];
+}
 
-	const Point& p0 = k0.control;
-	const Point  p1 = p0 + k0.right_tangent;
-	const Point& p3 = k1.control;
-	const Point  p2 = p3 + k1.left_tangent;
+float Curve::evaluate_curvature_by_percent( float t ) const
+{
+	Point points[3];
+	_evaluate_by_percent( t, points, 2 );
+
+	const Point& d1 = points[1];
+	const Point& d2 = points[2];
+
+	const float speed_sqr = d1.length_sqr();
+	if ( speed_sqr <= 0.0f ) return 0.0f;
 
-	return Utils::bezier_interp( p0, p1, p2, p3, t );
+	//  Curvature doesn't depend on the parametrization
+	return ( d1.x * d2.y - d1.y * d2.x ) 
+		 / ( speed_sqr * sqrtf( speed_sqr ) );
 }
 
-Point Curve::evaluate_by_distance( float dist ) const
+void Curve::evaluate_with_derivative_by_percent( 
+	float t, 
+	Point* point, 
+	Point* derivative 
+) const
 {
-	return evaluate_by_percent( dist / _length );
+	Point points[2];
+	_evaluate_by_percent( t, points, 1 );
+
+	*point = points[0];
+	*derivative = points[1];
 }
 
-float Curve::evaluate_by_time( float time ) const
+Point Curve::evaluate_derivative_by_distance( float dist ) const
 {
-	//  Bound evaluation to first & last points
-	const Point& first_point = get_key( 0 ).control;
-	const Point& last_point = get_key( get_keys_count() - 1 ).control;
-	if ( time <= first_point.x ) return first_point.y;
-	if ( time >= last_point.x ) return last_point.y;
+	return evaluate_derivative_by_percent( dist / _length ) / _length;
+}
 
-	//  Find evaluation points by time
-	int first_key_id, last_key_id;
-	find_evaluation_keys_id_by_time( 
-		&first_key_id, 
-		&last_key_id, 
-		time 
-	);
+Point Curve::evaluate_second_derivative_by_distance( float dist ) const
+{
+	return evaluate_second_derivative_by_percent( dist / _length ) 
+		 / ( _length * _length );
+}
 
-	//  Get keys in range
-	const CurveKey& k0 = get_key( first_key_id );
-	const CurveKey& k1 = get_key( last_key_id );
+float Curve::evaluate_curvature_by_distance( float dist ) const
+{
+	return evaluate_curvature_by_percent( dist / _length );
+}
 
-	//  Get control points
-	const Point& p0 = k0.control;
-	const Point& p3 = k1.control;
+float Curve::evaluate_derivative_by_time( float time ) const
+{
+	float values[2];
+	_evaluate_by_time( time, values, 1 );
+	return values[1];
+}
+
+float Curve::evaluate_second_derivative_by_time( float time ) const
+{
+	float values[3];
+	_evaluate_by_time( time, values, 2 );
+	return values[2];
+}
 
-	//  Get tangent points
-	const Point& t1 = k0.right_tangent;
-	const Point& t2 = k1.left_tangent;
-	/*const float m1 = t1.length();
-	const float m2 = t2.length();*/
+float Curve::evaluate_curvature_by_time( float time ) const
+{
+	float values[3];
+	_evaluate_by_time( time, values, 2 );
 
-	//  Compute time difference
-	const float time_diff = p3.x - p0.x;
-	if ( time_diff <= 0.0f ) return p0.y;
+	const float slope_sqr = 1.0f + values[1] * values[1];
+	return values[2] / ( slope_sqr * sqrtf( slope_sqr ) );
+}
 
-	//  Compute time ratio from p0 & p3 (from 0.0f to 1.0f)
-	const float t = ( time - p0.x ) / time_diff;
+void Curve::evaluate_with_derivative_by_time( 
+	float time, 
+	float* value, 
+	float* derivative 
+) const
+{
+	float values[2];
+	_evaluate_by_time( time, values, 1 );
+
+	*value = values[0];
+	*derivative = values[1];
+}
+
+void Curve::evaluate_by_time( 
+	const float* times, 
+	float* values, 
+	int count 
+) const
+{
+	for ( int i = 0; i < count; i++ )
+	{
+		values[i] = evaluate_by_time( times[i] );
+	}
+}
+
+void Curve::evaluate_with_derivative_by_time( 
+	const float* times, 
+	float* values, 
+	float* derivatives,
+	int count 
+) const
+{
+	for ( int i = 0; i < count; i++ )
+	{
+		float results[2];
+		_evaluate_by_time( times[i], results, 1 );
+
+		values[i] = results[0];
+		derivatives[i] = results[1];
+	}
+}
+
+void Curve::distribute_by_distance( 
+	int count, 
+	Point* points, 
+	Point* tangents,
+	const float steps
+) const
+{
+	const int curves_count = get_curves_count();
+	if ( count <= 0 || curves_count <= 0 ) return;
+
+	//  Keep the same samples density as 'compute_length'
+	const int samples_count = std::max( 1, 
+		(int)ceilf( 1.0f / ( steps * curves_count ) ) );
+
+	//  Sample the curve once, recording the cumulative length at 
+	//  each sample, each segment starting with a null ratio
+	struct ArcLengthSample
+	{
+		int curve_id;
+		float t;
+		float distance;
+	};
+	std::vector<ArcLengthSample> samples;
+	samples.reserve( curves_count * ( samples_count + 1 ) );
+
+	float length = 0.0f;
+	Point end_point = get_key( 0 ).control;
+	Point end_tangent {};
+	for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
+	{
+		//  Constant segments have no length
+		const CurveKey& key = get_key( curve_id );
+		if ( key.interpolation_mode == InterpolationMode::Constant ) 
+			continue;
+
+		Point p0, p1, p2, p3;
+		get_segment_points( curve_id, &p0, &p1, &p2, &p3 );
+
+		//  Linear segments are exact with a single sample
+		const int segment_samples_count = 
+			key.interpolation_mode == InterpolationMode::Linear 
+			? 1 : samples_count;
+
+		samples.push_back( { curve_id, 0.0f, length } );
+
+		Point last_point = p0;
+		for ( int i = 1; i <= segment_samples_count; i++ )
+		{
+			const float t = (float)i / segment_samples_count;
+			const Point point = Utils::bezier_interp( p0, p1, p2, p3, t );
+
+			length += ( point - last_point ).length();
+			samples.push_back( { curve_id, t, length } );
+			last_point = point;
+		}
 
-	//  Compute tangents Y-positions
-	/*const float y1 = p0.y + atan2f( t1.y / m1, t1.x / m1 ) * time_diff * m1 / 3.0f;
-	const float y2 = p3.y + atan2f( t2.y / m2, t2.x / m2 ) * time_diff * m2 / 3.0f;*/
-	const float y1 = p0.y + t1.y;
-	const float y2 = p3.y + t2.y;
+		end_point = p3;
+		end_tangent = Utils::bezier_derivative( p0, p1, p2, p3, 1.0f );
+		if ( end_tangent.length_sqr() == 0.0f )
+		{
+			end_tangent = p3 - p0;
+		}
+	}
+
+	const float spacing = count > 1 ? length / ( count - 1 ) : 0.0f;
+
+	//  Place each point inside the sample containing its distance,
+	//  interpolating the sample ratios linearly
+	int point_id = 0;
+	int sample_id = 0;
+	int segment_curve_id = -1;
+	Point p0, p1, p2, p3;
+	const int last_sample_id = (int)samples.size() - 1;
+	for ( ; point_id < count; point_id++ )
+	{
+		const float distance = point_id * spacing;
+		while ( sample_id < last_sample_id 
+			 && ( samples[sample_id + 1].distance < distance 
+			   || samples[sample_id + 1].t == 0.0f ) )
+		{
+			sample_id++;
+		}
+
+		//  Remaining points, due to rounding errors, are at the end
+		if ( sample_id >= last_sample_id 
+		  || samples[sample_id + 1].distance < distance ) break;
+
+		const ArcLengthSample& start = samples[sample_id];
+		const ArcLengthSample& end = samples[sample_id + 1];
+		if ( start.curve_id != segment_curve_id )
+		{
+			segment_curve_id = start.curve_id;
+			get_segment_points( segment_curve_id, &p0, &p1, &p2, &p3 );
+		}
+
+		const float sample_length = end.distance - start.distance;
+		const float ratio = sample_length > 0.0f 
+			? ( distance - start.distance ) / sample_length 
+			: 0.0f;
+		const float point_t = start.t + ( end.t - start.t ) * ratio;
+
+		points[point_id] = Utils::bezier_interp( p0, p1, p2, p3, point_t );
+		if ( tangents != nullptr )
+		{
+			//  Fallback to the sample direction on cusps
+			Point tangent = Utils::bezier_derivative( 
+				p0, p1, p2, p3, point_t );
+			if ( tangent.length_sqr() == 0.0f )
+			{
+				tangent = Utils::bezier_interp( p0, p1, p2, p3, end.t ) 
+						- Utils::bezier_interp( p0, p1, p2, p3, start.t );
+			}
+
+			tangents[point_id] = tangent.length_sqr() > 0.0f 
+				? tangent.normalized() : tangent;
+		}
+	}
 
-	return Utils::bezier_interp( p0.y, y1, y2, p3.y, t );
+	if ( end_tangent.length_sqr() > 0.0f )
+	{
+		end_tangent = end_tangent.normalized();
+	}
+	for ( ; point_id < count; point_id++ )
+	{
+		points[point_id] = end_point;
+		if ( tangents != nullptr )
+		{
+			tangents[point_id] = end_tangent;
+		}
+	}
 }
 
 void Curve::add_key( const CurveKey& key )
 {
 	_keys.push_back( key );
 
-	is_length_dirty = true;
+	_on_key_inserted( get_keys_count() - 1 );
 }
 
 void Curve::insert_key( int key_id, const CurveKey& key )
@@ -90,7 +346,29 @@ void Curve::insert_key( int key_id, const CurveKey& key )
 	auto itr = _keys.begin() + key_id;
 	_keys.insert( itr, key );
 
-	is_length_dirty = true;
+	_on_key_inserted( key_id );
+}
+
+void Curve::assign_keys( const CurveKey* keys, int count )
+{
+	_keys.assign( keys, keys + count );
+
+	mark_dirty();
+}
+
+int Curve::insert_key_by_time( const CurveKey& key )
+{
+	auto itr = std::upper_bound( _keys.begin(), _keys.end(), key,
+		[]( const CurveKey& a, const CurveKey& b )
+		{
+			return a.control.x < b.control.x;
+		}
+	);
+	itr = _keys.insert( itr, key );
+
+	int key_id = (int)( itr - _keys.begin() );
+	_on_key_inserted( key_id );
+	return key_id;
 }
 
 void Curve::remove_key( int key_id )
@@ -98,17 +376,255 @@ void Curve::remove_key( int key_id )
 	auto itr = _keys.begin() + key_id;
 	_keys.erase( itr );
 
-	is_length_dirty = true;
+	_on_key_removed( key_id );
+}
+
+CurveSimplification Curve::simplify( float tolerance )
+{
+	CurveSimplification simplification;
+	if ( get_keys_count() <= 2 ) return simplification;
+
+	//  Errors are measured against the original keys, each kept 
+	//  key remembering its original index
+	const std::vector<CurveKey> original_keys( _keys.begin(), _keys.end() );
+	std::vector<int> original_ids( original_keys.size() );
+	for ( int key_id = 0; key_id < (int)original_ids.size(); key_id++ )
+	{
+		original_ids[key_id] = key_id;
+	}
+
+	//  Achieved errors of each segment
+	std::vector<CurveSimplification> segments_errors( get_curves_count() );
+
+	std::vector<Point> samples;
+	std::vector<float> parameters;
+	int key_id = 1;
+	while ( key_id < get_keys_count() - 1 )
+	{
+		CurveKey start_key = get_key( key_id - 1 );
+		CurveKey end_key = get_key( key_id + 1 );
+		const InterpolationMode mode = start_key.interpolation_mode;
+		if ( get_key( key_id ).interpolation_mode != mode )
+		{
+			key_id++;
+			continue;
+		}
+
+		//  Sample the original segments spanned by the merged one
+		const int first_original_id = original_ids[key_id - 1];
+		const int last_original_id = original_ids[key_id + 1];
+		samples.clear();
+		parameters.clear();
+		bool is_sorted_by_time = true;
+		for ( int original_id = first_original_id; original_id < last_original_id; original_id++ )
+		{
+			const CurveKey& k0 = original_keys[original_id];
+			const CurveKey& k1 = original_keys[original_id + 1];
+			is_sorted_by_time &= k0.control.x <= k1.control.x;
+
+			Point p0, p1, p2, p3;
+			compute_segment_points( k0, k1, &p0, &p1, &p2, &p3 );
+			for ( int i = 0; i < SIMPLIFICATION_SAMPLES_COUNT; i++ )
+			{
+				const float t = (float)i / SIMPLIFICATION_SAMPLES_COUNT;
+				samples.push_back( Utils::bezier_interp( p0, p1, p2, p3, t ) );
+			}
+		}
+		samples.push_back( original_keys[last_original_id].control );
+
+		//  Parameterize samples by chord length
+		parameters.push_back( 0.0f );
+		for ( size_t i = 1; i < samples.size(); i++ )
+		{
+			parameters.push_back( parameters.back() 
+				+ ( samples[i] - samples[i - 1] ).length() );
+		}
+		for ( float& parameter : parameters )
+		{
+			parameter = parameters.back() > 0.0f 
+				? parameter / parameters.back() : 0.0f;
+		}
+
+		//  Re-solve the lengths of the tangents facing the removed 
+		//  key, see "An Algorithm for Automatically Fitting 
+		//  Digitized Curves" by Philip J. Schneider
+		const Point& p0 = start_key.control;
+		const Point& p3 = end_key.control;
+		const bool is_start_free = 
+			start_key.tangent_mode != TangentMode::Mirrored 
+			&& start_key.right_tangent.length_sqr() > 0.0f;
+		const bool is_end_free = 
+			end_key.tangent_mode != TangentMode::Mirrored
+			&& end_key.left_tangent.length_sqr() > 0.0f;
+		if ( mode == InterpolationMode::Cubic 
+		  && ( is_start_free || is_end_free ) )
+		{
+			const Point direction_1 = is_start_free 
+				? start_key.right_tangent.normalized() : Point();
+			const Point direction_2 = is_end_free 
+				? end_key.left_tangent.normalized() : Point();
+
+			float c00 = 0.0f, c01 = 0.0f, c11 = 0.0f;
+			float x0 = 0.0f, x1 = 0.0f;
+			for ( size_t i = 0; i < samples.size(); i++ )
+			{
+				const float t = parameters[i];
+				const float it = 1.0f - t;
+				const float b0 = it * it * it;
+				const float b1 = 3.0f * it * it * t;
+				const float b2 = 3.0f * it * t * t;
+				const float b3 = t * t * t;
+
+				//  Fixed tangents are part of the known terms
+				Point rest = samples[i] - ( p0 * ( b0 + b1 ) + p3 * ( b2 + b3 ) );
+				if ( !is_start_free ) rest = rest - start_key.right_tangent * b1;
+				if ( !is_end_free ) rest = rest - end_key.left_tangent * b2;
+
+				const Point a1 = direction_1 * b1;
+				const Point a2 = direction_2 * b2;
+				c00 += a1.x * a1.x + a1.y * a1.y;
+				c01 += a1.x * a2.x + a1.y * a2.y;
+				c11 += a2.x * a2.x + a2.y * a2.y;
+				x0 += a1.x * rest.x + a1.y * rest.y;
+				x1 += a2.x * rest.x + a2.y * rest.y;
+			}
+
+			float alpha_1 = -1.0f, alpha_2 = -1.0f;
+			if ( is_start_free && is_end_free )
+			{
+				const float determinant = c00 * c11 - c01 * c01;
+				if ( determinant != 0.0f )
+				{
+					alpha_1 = ( x0 * c11 - x1 * c01 ) / determinant;
+					alpha_2 = ( c00 * x1 - c01 * x0 ) / determinant;
+				}
+			}
+			else if ( is_start_free && c00 > 0.0f )
+			{
+				alpha_1 = x0 / c00;
+			}
+			else if ( is_end_free && c11 > 0.0f )
+			{
+				alpha_2 = x1 / c11;
+			}
+
+			//  Keep the current lengths on degenerate solutions
+			if ( is_start_free && alpha_1 > 0.0f )
+			{
+				start_key.right_tangent = direction_1 * alpha_1;
+			}
+			if ( is_end_free && alpha_2 > 0.0f )
+			{
+				end_key.left_tangent = direction_2 * alpha_2;
+			}
+		}
+
+		//  Measure the geometric deviation, projecting samples on 
+		//  the merged segment with Newton's method. Constant 
+		//  segments have no path, only their values matter.
+		CurveSimplification errors;
+		Point p0_segment, p1, p2, p3_segment;
+		compute_segment_points( start_key, end_key, 
+			&p0_segment, &p1, &p2, &p3_segment );
+		const bool has_path = mode != InterpolationMode::Constant;
+		for ( size_t i = 0; has_path && i < samples.size(); i++ )
+		{
+			float t = parameters[i];
+			for ( int step = 0; step < 3; step++ )
+			{
+				const Point diff = Utils::bezier_interp( 
+					p0_segment, p1, p2, p3_segment, t ) - samples[i];
+				const Point derivative = Utils::bezier_derivative( 
+					p0_segment, p1, p2, p3_segment, t );
+				const Point second_derivative = Utils::bezier_second_derivative( 
+					p0_segment, p1, p2, p3_segment, t );
+				const float denominator = derivative.length_sqr() 
+					+ diff.x * second_derivative.x + diff.y * second_derivative.y;
+				if ( denominator == 0.0f ) break;
+
+				t -= ( diff.x * derivative.x + diff.y * derivative.y ) / denominator;
+				t = fminf( fmaxf( t, 0.0f ), 1.0f );
+			}
+
+			const Point point = Utils::bezier_interp( 
+				p0_segment, p1, p2, p3_segment, t );
+			errors.geometry_error = fmaxf( errors.geometry_error, 
+				( point - samples[i] ).length() );
+		}
+
+		//  Measure the deviation by time, where it is meaningful
+		const float time_diff = p3.x - p0.x;
+		if ( is_sorted_by_time && time_diff > 0.0f )
+		{
+			for ( int original_id = first_original_id; original_id < last_original_id; original_id++ )
+			{
+				const CurveKey& k0 = original_keys[original_id];
+				const CurveKey& k1 = original_keys[original_id + 1];
+
+				Point o0, o1, o2, o3;
+				compute_segment_points( k0, k1, &o0, &o1, &o2, &o3 );
+				for ( int i = 1; i <= SIMPLIFICATION_SAMPLES_COUNT; i++ )
+				{
+					const float t = (float)i / SIMPLIFICATION_SAMPLES_COUNT;
+					const float time = k0.control.x 
+						+ ( k1.control.x - k0.control.x ) * t;
+					const float value = i < SIMPLIFICATION_SAMPLES_COUNT
+						? Utils::bezier_interp( o0.y, o1.y, o2.y, o3.y, t )
+						: k1.control.y;
+
+					//  Merged constant segments never reach their end
+					const float merged_t = ( time - p0.x ) / time_diff;
+					const float merged_value = merged_t >= 1.0f 
+						? p3.y 
+						: Utils::bezier_interp( 
+							p0_segment.y, p1.y, p2.y, p3_segment.y, merged_t );
+					errors.time_error = fmaxf( errors.time_error, 
+						fabsf( merged_value - value ) );
+				}
+			}
+		}
+
+		if ( errors.geometry_error > tolerance || errors.time_error > tolerance )
+		{
+			key_id++;
+			continue;
+		}
+
+		//  Apply the merge
+		get_key( key_id - 1 ).right_tangent = start_key.right_tangent;
+		get_key( key_id + 1 ).left_tangent = end_key.left_tangent;
+		remove_key( key_id );
+		original_ids.erase( original_ids.begin() + key_id );
+
+		segments_errors[key_id - 1] = errors;
+		segments_errors.erase( segments_errors.begin() + key_id );
+		simplification.removed_keys_count++;
+	}
+
+	for ( const CurveSimplification& errors : segments_errors )
+	{
+		simplification.time_error = fmaxf( 
+			simplification.time_error, errors.time_error );
+		simplification.geometry_error = fmaxf( 
+			simplification.geometry_error, errors.geometry_error );
+	}
+
+	return simplification;
+}
+
+void Curve::reserve( int keys_count )
+{
+	_keys.reserve( keys_count );
 }
 
-CurveKey& Curve::get_key( int key_id )
+void Curve::shrink_to_fit()
 {
-	return _keys[key_id];
+	_keys.shrink_to_fit();
 }
 
-const CurveKey& Curve::get_key( int key_id ) const
+int Curve::get_capacity() const
 {
-	return _keys[key_id];
+	return (int)_keys.capacity();
 }
 
 void Curve::set_point( int point_id, const Point& point )
@@ -129,7 +645,7 @@ void Curve::set_point( int point_id, const Point& point )
 			break;
 	}
 
-	is_length_dirty = true;
+	mark_key_dirty( key_id );
 }
 
 void Curve::set_tangent_point( 
@@ -163,7 +679,7 @@ void Curve::set_tangent_point(
 			break;
 	}
 
-	is_length_dirty = true;
+	mark_key_dirty( key_id );
 }
 
 Point Curve::get_point( int point_id, PointSpace point_space ) const
@@ -204,23 +720,96 @@ float Curve::get_nearest_distance_to(
 	const float steps 
 ) const
 {
-	float nearest_point_distance = INFINITY;
-	float curve_distance = 0.0f;
+	const int curves_count = get_curves_count();
+	if ( curves_count <= 0 ) return 0.0f;
+
+	//  Convert the distance steps into a samples count per segment
+	const int samples_count = std::max( 1, 
+		(int)( _length / steps / curves_count ) );
 
-	//  Find iteratively the nearest point on the curve
-	for ( float d = 0.0f; d < _length + steps; d += steps )
+	float nearest_distance_sqr = INFINITY;
+	float nearest_percent = 0.0f;
+
+	//  Find the nearest point of each segment
+	for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
 	{
-		Point point = evaluate_by_distance( d );
+		const CurveKey& k0 = get_key( curve_id );
+		const CurveKey& k1 = get_key( curve_id + 1 );
+		const Point& p0 = k0.control;
+		const Point& p3 = k1.control;
+
+		float segment_t = 0.0f;
+		float segment_distance_sqr = INFINITY;
+
+		switch ( k0.interpolation_mode )
+		{
+			//  Only the first control point is reached, the next 
+			//  one belongs to the next segment
+			case InterpolationMode::Constant:
+			{
+				segment_distance_sqr = ( target_point - p0 ).length_sqr();
+
+				//  ..unless it is the last segment
+				const float end_distance_sqr = 
+					( target_point - p3 ).length_sqr();
+				if ( curve_id == curves_count - 1 
+				  && end_distance_sqr < segment_distance_sqr )
+				{
+					segment_t = 1.0f;
+					segment_distance_sqr = end_distance_sqr;
+				}
+				break;
+			}
+			//  Project the point on the line
+			case InterpolationMode::Linear:
+			{
+				const Point direction = p3 - p0;
+				const float length_sqr = direction.length_sqr();
+				if ( length_sqr > 0.0f )
+				{
+					const Point offset = target_point - p0;
+					segment_t = ( offset.x * direction.x 
+								+ offset.y * direction.y ) / length_sqr;
+					segment_t = fmaxf( fminf( segment_t, 1.0f ), 0.0f );
+				}
+
+				const Point point = p0 + direction * segment_t;
+				segment_distance_sqr = ( target_point - point ).length_sqr();
+				break;
+			}
+			//  Find iteratively the nearest point on the segment
+			default:
+			{
+				const Point p1 = p0 + k0.right_tangent;
+				const Point p2 = p3 + k1.left_tangent;
+				for ( int i = 0; i <= samples_count; i++ )
+				{
+					const float t = (float)i / samples_count;
+					const Point point = 
+						Utils::bezier_interp( p0, p1, p2, p3, t );
+
+					const float distance_sqr = 
+						( target_point - point ).length_sqr();
+					if ( distance_sqr < segment_distance_sqr )
+					{
+						segment_distance_sqr = distance_sqr;
+						segment_t = t;
+					}
+				}
+				break;
+			}
+		}
 
-		float distance = ( target_point - point ).length_sqr();
-		if ( distance < nearest_point_distance )
+		if ( segment_distance_sqr < nearest_distance_sqr )
 		{
-			nearest_point_distance = distance;
-			curve_distance = d;
+			nearest_distance_sqr = segment_distance_sqr;
+			nearest_percent = ( curve_id + segment_t ) / curves_count;
 		}
 	}
 
-	return curve_distance;
+	//  Convert the percent into a distance, as expected by 
+	//  'evaluate_by_distance'
+	return nearest_percent * _length;
 }
 
 int Curve::point_to_key_id( int point_id ) const
@@ -245,6 +834,8 @@ void Curve::set_tangent_mode(
 	if ( should_apply_constraint )
 	{
 		key.set_left_tangent( key.left_tangent );
+
+		mark_key_dirty( key_id );
 	}
 }
 
@@ -320,66 +911,129 @@ CurveExtrems Curve::get_extrems() const
 	return extrems;
 }
 
-void Curve::find_evaluation_keys_id_by_time( 
-	int* first_key_id,
-	int* last_key_id,
-	float time 
-) const
+CurveExtrems Curve::get_bounds()
+{
+	if ( _is_segments_cache_dirty )
+	{
+		update_segments_cache();
+	}
+
+	return _bounds;
+}
+
+CurveExtrems Curve::get_bounds() const
 {
-	/*
-	 * Perform a lower bound to find out the two control points
-	 * to evaluate from.
-	 * 
-	 * Code highly inspired on Unreal Engine's code
-	 */
+	return _bounds;
+}
 
-	int first_id = 1;
-	int last_id = get_keys_count() - 1;
+CurveExtrems Curve::get_segment_bounds( int curve_id ) const
+{
+	return _segments_cache[curve_id].bounds;
+}
 
-	int count = last_id - first_id;
-	while ( count > 0 )
+Monotonicity Curve::get_monotonicity()
+{
+	if ( _is_segments_cache_dirty )
 	{
-		int step = count / 2;
-		int middle_id = first_id + step;
+		update_segments_cache();
+	}
 
-		if ( time >= get_key( middle_id ).control.x )
-		{
-			first_id = middle_id + 1;
-			count -= step + 1;
-		}
-		else
-		{
-			count = step;
-		}
+	return _monotonicity;
+}
+
+Monotonicity Curve::get_monotonicity() const
+{
+	return _monotonicity;
+}
+
+Monotonicity Curve::get_segment_monotonicity( int curve_id ) const
+{
+	return _segments_cache[curve_id].monotonicity;
+}
+
+bool Curve::inverse_evaluate_by_time( float value, float* time )
+{
+	if ( _is_segments_cache_dirty )
+	{
+		update_segments_cache();
 	}
 
-	*first_key_id = first_id - 1;
-	*last_key_id = first_id;
+	return std::as_const( *this ).inverse_evaluate_by_time( value, time );
 }
 
-void Curve::find_evaluation_keys_id_by_percent(
-	int* first_key_id,
-	int* last_key_id,
-	float& t
-) const
+bool Curve::inverse_evaluate_by_time( float value, float* time ) const
 {
-	int key_id = -1;
+	if ( _monotonicity == Monotonicity::None || !is_valid() ) 
+		return false;
+
+	//  Check the value is reached by the curve
+	const Point& first_point = get_key( 0 ).control;
+	const Point& last_point = get_key( get_keys_count() - 1 ).control;
+	if ( value < fminf( first_point.y, last_point.y ) 
+	  || value > fmaxf( first_point.y, last_point.y ) ) 
+		return false;
+
+	//  Find the first key reaching the value, keys values being
+	//  sorted in the same order as the curve variation
+	const float sign = _monotonicity == Monotonicity::Decreasing 
+		? -1.0f : 1.0f;
+	auto itr = std::lower_bound( 
+		_keys.begin(), 
+		_keys.end(), 
+		value * sign,
+		[sign]( const CurveKey& key, float signed_value ) {
+			return key.control.y * sign < signed_value;
+		}
+	);
 
-	if ( t >= 1.0f )
+	const int key_id = (int)( itr - _keys.begin() );
+	if ( key_id == 0 )
 	{
-		t = 1.0f;
-		
-		key_id = get_keys_count() - 2;
+		*time = first_point.x;
+		return true;
 	}
-	else
+	if ( itr->control.y == value )
 	{
-		t = fmaxf( t, 0.0f ) * get_curves_count();
-		key_id = (int)floorf( t );
-		t -= (float)key_id;
+		*time = itr->control.x;
+		return true;
 	}
 
-	*first_key_id = key_id;
-	*last_key_id = key_id + 1;
+	//  Solve the segment ending with the found key
+	const int curve_id = key_id - 1;
+	const CurveKey& k0 = get_key( curve_id );
+	const CurveKey& k1 = get_key( key_id );
+	const float time_diff = k1.control.x - k0.control.x;
+	switch ( k0.interpolation_mode )
+	{
+		//  The value is only reached at the next key
+		case InterpolationMode::Constant:
+			*time = k1.control.x;
+			break;
+		case InterpolationMode::Linear:
+			*time = k0.control.x + time_diff 
+				  * ( value - k0.control.y ) 
+				  / ( k1.control.y - k0.control.y );
+			break;
+		default:
+			*time = k0.control.x 
+				  + time_diff * _solve_segment_by_value( 
+					curve_id, value, 0.0f, 1.0f );
+			break;
+	}
+
+	return true;
+}
+
+void Curve::get_segment_points( 
+	int curve_id,
+	Point* p0, Point* p1, 
+	Point* p2, Point* p3 
+) const
+{
+	compute_segment_points( 
+		get_key( curve_id ), get_key( curve_id + 1 ), 
+		p0, p1, p2, p3 
+	);
 }
 
 void Curve::find_evaluation_keys_id_by_distance( 
@@ -405,16 +1059,6 @@ void Curve::find_evaluation_keys_id_by_distance(
 	*last_key_id = *first_key_id;
 }
 
-int Curve::get_keys_count() const
-{
-	return (int)_keys.size();
-}
-
-int Curve::get_curves_count() const
-{
-	return get_keys_count() - 1;
-}
-
 int Curve::get_points_count() const
 {
 	//  3 points per key: control, left tangent and right tangent
@@ -440,47 +1084,863 @@ void Curve::compute_length( const float steps )
 {
 	_length = 0.0f;
 
-	int current_key_id = 0;
-	CurveKey* current_key = &get_key( current_key_id );
-	//current_key.distance = 0.0f;
-
-	float last_distance_to_key = 0.0f;
-	Point last_point = current_key->control;
-	for ( float t = steps; t < 1.0f; t += steps )
+	const int curves_count = get_curves_count();
+	if ( curves_count > 0 )
 	{
-		const Point point = evaluate_by_percent( t );
+		//  Keep the same samples density across the whole curve
+		const int samples_count = std::max( 1, 
+			(int)ceilf( 1.0f / ( steps * curves_count ) ) );
 
-		//  Attribute distances to keys
-		//  TODO: fix distance computation for keys
-		/*float distance_to_key = 
-			( point - current_key->control ).length_sqr();
-		if ( distance_to_key <= 5.0f 
-		  && distance_to_key > last_distance_to_key )
+		for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
 		{
-			//  Set current key's distance
-			current_key->distance = 
-				_length - sqrtf( last_distance_to_key );
+			_length += _compute_segment_length( curve_id, samples_count );
+		}
+	}
 
-			//  Set current to next key
-			current_key = &get_key( ++current_key_id );
+	is_length_dirty = false;
+}
 
-			//  Compute new distance
-			last_distance_to_key = 
-				( point - current_key->control ).length_sqr();
-		}
-		else
-		{
-			last_distance_to_key = distance_to_key;
-		}*/
+InterpolationMode Curve::get_interpolation_mode( int key_id ) const
+{
+	return get_key( key_id ).interpolation_mode;
+}
+
+void Curve::set_interpolation_mode( int key_id, InterpolationMode mode )
+{
+	get_key( key_id ).interpolation_mode = mode;
 
-		//  Add distance to length
-		_length += ( point - last_point ).length();
+	mark_key_dirty( key_id );
+}
 
-		last_point = point;
+std::pmr::memory_resource* Curve::get_memory_resource() const
+{
+	return _keys.get_allocator().resource();
+}
+
+uint64_t Curve::get_revision() const
+{
+	//  Only generated when requested, so that modifying curves 
+	//  doesn't touch the shared counter
+	if ( _revision == 0 )
+	{
+		_revision = generate_revision();
 	}
 
-	//  Set last key's distance to length
-	//current_key->distance = _length;
+	return _revision;
+}
 
-	is_length_dirty = false;
+CompiledCurve Curve::compile() const
+{
+	return CompiledCurve( *this );
+}
+
+void Curve::update_segments_cache()
+{
+	const int curves_count = get_curves_count();
+
+	//  Bounds can't be merged from segments without any
+	if ( curves_count <= 0 )
+	{
+		_segments_cache.clear();
+		_prefix_integrals.clear();
+		_monotonicity = Monotonicity::Constant;
+		_bounds = CurveSegmentCache().bounds;
+
+		//  A single key is still integrated as a constant, from an
+		//  empty prefix
+		if ( get_keys_count() == 1 )
+		{
+			const Point& point = get_key( 0 ).control;
+			_bounds = { point.x, point.x, point.y, point.y };
+			_prefix_integrals.assign( 1, 0.0f );
+		}
+
+		_is_segments_cache_dirty = false;
+		return;
+	}
+
+	//  Resize the cache if it is not aligned with the keys, or 
+	//  if the bounds have been invalidated
+	bool should_merge_all = _bounds.min_x > _bounds.max_x;
+	if ( (int)_segments_cache.size() != curves_count )
+	{
+		_segments_cache.assign( curves_count, CurveSegmentCache() );
+		should_merge_all = true;
+	}
+
+	//  Update dirty segments and merge their new bounds. As long
+	//  as the previous bounds of the segments were not touching 
+	//  the curve bounds, the curve bounds can only grow.
+	int first_dirty_curve_id = curves_count;
+	for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
+	{
+		CurveSegmentCache& cache = _segments_cache[curve_id];
+		if ( !cache.is_dirty ) continue;
+
+		first_dirty_curve_id = std::min( first_dirty_curve_id, curve_id );
+
+		const CurveExtrems& old_bounds = cache.bounds;
+		if ( old_bounds.min_x <= _bounds.min_x 
+		  || old_bounds.max_x >= _bounds.max_x
+		  || old_bounds.min_y <= _bounds.min_y 
+		  || old_bounds.max_y >= _bounds.max_y )
+		{
+			should_merge_all = true;
+		}
+
+		_compute_segment_cache( curve_id, &cache );
+
+		if ( !should_merge_all )
+		{
+			_bounds.min_x = fminf( _bounds.min_x, cache.bounds.min_x );
+			_bounds.max_x = fmaxf( _bounds.max_x, cache.bounds.max_x );
+			_bounds.min_y = fminf( _bounds.min_y, cache.bounds.min_y );
+			_bounds.max_y = fmaxf( _bounds.max_y, cache.bounds.max_y );
+		}
+	}
+
+	//  Merge bounds of all segments
+	if ( should_merge_all )
+	{
+		_bounds = CurveSegmentCache().bounds;
+		for ( const CurveSegmentCache& cache : _segments_cache )
+		{
+			_bounds.min_x = fminf( _bounds.min_x, cache.bounds.min_x );
+			_bounds.max_x = fmaxf( _bounds.max_x, cache.bounds.max_x );
+			_bounds.min_y = fminf( _bounds.min_y, cache.bounds.min_y );
+			_bounds.max_y = fmaxf( _bounds.max_y, cache.bounds.max_y );
+		}
+	}
+
+	//  Accumulate integrals, only from the first modified segment
+	if ( (int)_prefix_integrals.size() != curves_count + 1 )
+	{
+		_prefix_integrals.assign( curves_count + 1, 0.0f );
+		first_dirty_curve_id = 0;
+	}
+	for ( int curve_id = first_dirty_curve_id; curve_id < curves_count; curve_id++ )
+	{
+		_prefix_integrals[curve_id + 1] = _prefix_integrals[curve_id] 
+			+ _segments_cache[curve_id].integral;
+	}
+
+	//  Merge variations, ignoring constant segments
+	_monotonicity = Monotonicity::Constant;
+	for ( const CurveSegmentCache& cache : _segments_cache )
+	{
+		if ( cache.monotonicity == Monotonicity::Constant 
+		  || cache.monotonicity == _monotonicity ) continue;
+
+		if ( _monotonicity != Monotonicity::Constant 
+		  || cache.monotonicity == Monotonicity::None )
+		{
+			_monotonicity = Monotonicity::None;
+			break;
+		}
+
+		_monotonicity = cache.monotonicity;
+	}
+
+	_is_segments_cache_dirty = false;
+}
+
+void Curve::mark_key_dirty( int key_id )
+{
+	is_length_dirty = true;
+	_is_segments_cache_dirty = true;
+	_revision = 0;
+
+	//  Segments are only marked if the cache is aligned with the 
+	//  keys, otherwise all of them are computed on next update
+	const int segments_count = (int)_segments_cache.size();
+	if ( segments_count != get_curves_count() ) return;
+
+	//  A key belongs to the segments on both of its sides
+	if ( key_id - 1 >= 0 && key_id - 1 < segments_count )
+	{
+		_segments_cache[key_id - 1].is_dirty = true;
+	}
+	if ( key_id >= 0 && key_id < segments_count )
+	{
+		_segments_cache[key_id].is_dirty = true;
+	}
+}
+
+void Curve::mark_dirty()
+{
+	is_length_dirty = true;
+	_is_segments_cache_dirty = true;
+	_revision = 0;
+
+	_segments_cache.clear();
+}
+
+void Curve::_on_key_inserted( int key_id )
+{
+	//  Insert a segment, unless the cache is not aligned with the
+	//  keys anymore (i.e. the segment count before insertion)
+	const int segments_count = (int)_segments_cache.size();
+	if ( segments_count > 0 && segments_count == get_curves_count() - 1 )
+	{
+		const int curve_id = std::min( key_id, segments_count );
+		_segments_cache.insert( 
+			_segments_cache.begin() + curve_id, 
+			CurveSegmentCache() 
+		);
+	}
+
+	mark_key_dirty( key_id );
+}
+
+void Curve::_on_key_removed( int key_id )
+{
+	//  Remove a segment, unless the cache is not aligned with the
+	//  keys anymore (i.e. the segment count before removal)
+	const int segments_count = (int)_segments_cache.size();
+	if ( segments_count > 0 && segments_count == get_curves_count() + 1 )
+	{
+		const int curve_id = std::min( key_id, segments_count - 1 );
+
+		//  Invalidate the curve bounds if the removed segment was 
+		//  touching them, since they may shrink
+		const CurveExtrems& bounds = _segments_cache[curve_id].bounds;
+		if ( bounds.min_x <= _bounds.min_x 
+		  || bounds.max_x >= _bounds.max_x
+		  || bounds.min_y <= _bounds.min_y 
+		  || bounds.max_y >= _bounds.max_y )
+		{
+			_bounds = CurveSegmentCache().bounds;
+		}
+
+		_segments_cache.erase( _segments_cache.begin() + curve_id );
+	}
+
+	//  The previous key now forms a segment with the next one
+	mark_key_dirty( key_id - 1 );
+}
+
+void Curve::_compute_segment_cache( 
+	int curve_id, 
+	CurveSegmentCache* cache 
+) const
+{
+	const Point& p0 = get_key( curve_id ).control;
+	const Point& p3 = get_key( curve_id + 1 ).control;
+
+	//  Start with the bounds of both control points, which are
+	//  the exact bounds of constant and linear segments
+	CurveExtrems& bounds = cache->bounds;
+	bounds.min_x = fminf( p0.x, p3.x );
+	bounds.max_x = fmaxf( p0.x, p3.x );
+	bounds.min_y = fminf( p0.y, p3.y );
+	bounds.max_y = fmaxf( p0.y, p3.y );
+
+	cache->integral = _integrate_segment( curve_id, 1.0f );
+	cache->is_dirty = false;
+
+	//  Constant and linear segments vary like their control points
+	cache->monotonicity = p0.y < p3.y ? Monotonicity::Increasing
+						: p0.y > p3.y ? Monotonicity::Decreasing 
+						: Monotonicity::Constant;
+
+	if ( get_key( curve_id ).interpolation_mode != InterpolationMode::Cubic )
+		return;
+
+	const Point p1 = p0 + get_key( curve_id ).right_tangent;
+	const Point p2 = p3 + get_key( curve_id + 1 ).left_tangent;
+
+	//  Extend to the extrems found at the roots of the derivative,
+	//  a quadratic Bézier formed by the differences of the points
+	const Point d0 = p1 - p0;
+	const Point d1 = p2 - p1;
+	const Point d2 = p3 - p2;
+	const Point a = d0 - d1 * 2.0f + d2;
+	const Point b = ( d1 - d0 ) * 2.0f;
+
+	float roots[4];
+	int roots_count = Utils::solve_quadratic( a.x, b.x, d0.x, roots );
+	roots_count += Utils::solve_quadratic( a.y, b.y, d0.y, 
+		roots + roots_count );
+
+	for ( int i = 0; i < roots_count; i++ )
+	{
+		const float t = roots[i];
+		if ( t <= 0.0f || t >= 1.0f ) continue;
+
+		const Point point = Utils::bezier_interp( p0, p1, p2, p3, t );
+		bounds.min_x = fminf( bounds.min_x, point.x );
+		bounds.max_x = fmaxf( bounds.max_x, point.x );
+		bounds.min_y = fminf( bounds.min_y, point.y );
+		bounds.max_y = fmaxf( bounds.max_y, point.y );
+	}
+
+	//  Find the sign of the Y-axis derivative by its extrems, at 
+	//  both ends and at the vertex of the quadratic
+	float min_slope = fminf( d0.y, d2.y );
+	float max_slope = fmaxf( d0.y, d2.y );
+	if ( a.y != 0.0f )
+	{
+		const float t = -b.y / ( 2.0f * a.y );
+		if ( t > 0.0f && t < 1.0f )
+		{
+			const float slope = ( a.y * t + b.y ) * t + d0.y;
+			min_slope = fminf( min_slope, slope );
+			max_slope = fmaxf( max_slope, slope );
+		}
+	}
+
+	if ( min_slope >= 0.0f && max_slope > 0.0f )
+	{
+		cache->monotonicity = Monotonicity::Increasing;
+	}
+	else if ( max_slope <= 0.0f && min_slope < 0.0f )
+	{
+		cache->monotonicity = Monotonicity::Decreasing;
+	}
+	else if ( min_slope == 0.0f && max_slope == 0.0f )
+	{
+		cache->monotonicity = Monotonicity::Constant;
+	}
+	else
+	{
+		cache->monotonicity = Monotonicity::None;
+	}
+}
+
+int Curve::find_crossings_by_time( 
+	float value, 
+	float start_time, 
+	float end_time, 
+	std::vector<float>* times 
+)
+{
+	if ( _is_segments_cache_dirty )
+	{
+		update_segments_cache();
+	}
+
+	return std::as_const( *this ).find_crossings_by_time( 
+		value, start_time, end_time, times );
+}
+
+int Curve::find_crossings_by_time( 
+	float value, 
+	float start_time, 
+	float end_time, 
+	std::vector<float>* times 
+) const
+{
+	const int curves_count = get_curves_count();
+	if ( curves_count <= 0 || start_time >= end_time 
+	  || (int)_segments_cache.size() != curves_count ) 
+		return 0;
+
+	const size_t old_size = times->size();
+	bool is_below = evaluate_by_time( start_time ) < value;
+
+	//  Find the segments overlapping the interval, the curve is 
+	//  constant outside of the keys
+	int first_curve_id, last_curve_id, key_id;
+	find_evaluation_keys_id_by_time( &first_curve_id, &key_id, start_time );
+	find_evaluation_keys_id_by_time( &last_curve_id, &key_id, end_time );
+
+	for ( int curve_id = first_curve_id; curve_id <= last_curve_id; curve_id++ )
+	{
+		const Point& p0 = get_key( curve_id ).control;
+		const Point& p3 = get_key( curve_id + 1 ).control;
+
+		//  Crossing by the jump after a constant segment
+		if ( p0.x > start_time && p0.x <= end_time 
+		  && ( p0.y < value ) != is_below )
+		{
+			times->push_back( p0.x );
+			is_below = !is_below;
+		}
+
+		//  Constant segments hold the value of their first key
+		if ( get_key( curve_id ).interpolation_mode 
+		  == InterpolationMode::Constant ) continue;
+
+		//  Skip segments out of the value range
+		const CurveExtrems& bounds = _segments_cache[curve_id].bounds;
+		if ( value < bounds.min_y || value > bounds.max_y )
+		{
+			is_below = value > bounds.max_y;
+			continue;
+		}
+
+		const float time_diff = p3.x - p0.x;
+		if ( time_diff <= 0.0f ) continue;
+
+		const float min_t = fmaxf( ( start_time - p0.x ) / time_diff, 0.0f );
+		const float max_t = fminf( ( end_time - p0.x ) / time_diff, 1.0f );
+		if ( min_t >= max_t ) continue;
+
+		//  Isolate each root in a monotonic part of the segment
+		float ts[4] { min_t };
+		int ts_count = 1;
+		float turning_ts[2];
+		const int turning_count = _find_segment_turning_points( 
+			curve_id, turning_ts );
+		for ( int i = 0; i < turning_count; i++ )
+		{
+			if ( turning_ts[i] <= min_t || turning_ts[i] >= max_t ) 
+				continue;
+
+			ts[ts_count++] = turning_ts[i];
+		}
+		ts[ts_count++] = max_t;
+
+		Point p1, p2;
+		Point p0_segment, p3_segment;
+		get_segment_points( curve_id, &p0_segment, &p1, &p2, &p3_segment );
+		for ( int i = 1; i < ts_count; i++ )
+		{
+			const float y = Utils::bezier_interp( 
+				p0_segment.y, p1.y, p2.y, p3_segment.y, ts[i] );
+			if ( ( y < value ) == is_below ) continue;
+
+			const float t = _solve_segment_by_value( 
+				curve_id, value, ts[i - 1], ts[i] );
+			times->push_back( p0.x + t * time_diff );
+			is_below = !is_below;
+		}
+	}
+
+	//  Crossing by the jump after a constant last segment
+	const Point& last_point = get_key( curves_count ).control;
+	if ( last_point.x > start_time && last_point.x <= end_time 
+	  && ( last_point.y < value ) != is_below )
+	{
+		times->push_back( last_point.x );
+	}
+
+	return (int)( times->size() - old_size );
+}
+
+int Curve::find_local_extrems_by_time( 
+	float start_time, 
+	float end_time, 
+	std::vector<float>* times 
+)
+{
+	if ( _is_segments_cache_dirty )
+	{
+		update_segments_cache();
+	}
+
+	return std::as_const( *this ).find_local_extrems_by_time( 
+		start_time, end_time, times );
+}
+
+int Curve::find_local_extrems_by_time( 
+	float start_time, 
+	float end_time, 
+	std::vector<float>* times 
+) const
+{
+	const int curves_count = get_curves_count();
+	if ( curves_count <= 0 || start_time >= end_time 
+	  || (int)_segments_cache.size() != curves_count ) 
+		return 0;
+
+	const size_t old_size = times->size();
+
+	//  Walk the curve by monotonic parts, reporting the end of the
+	//  last non-flat part when the direction changes
+	float last_value = evaluate_by_time( start_time );
+	float turning_time = start_time;
+	float direction = 0.0f;
+	const auto add_part = [&]( float part_end_time, float part_end_value )
+	{
+		const float delta = part_end_value - last_value;
+		last_value = part_end_value;
+		if ( delta == 0.0f ) return;
+
+		const float part_direction = copysignf( 1.0f, delta );
+		if ( part_direction == -direction )
+		{
+			times->push_back( turning_time );
+		}
+
+		direction = part_direction;
+		turning_time = part_end_time;
+	};
+
+	int first_curve_id, last_curve_id, key_id;
+	find_evaluation_keys_id_by_time( &first_curve_id, &key_id, start_time );
+	find_evaluation_keys_id_by_time( &last_curve_id, &key_id, end_time );
+
+	for ( int curve_id = first_curve_id; curve_id <= last_curve_id; curve_id++ )
+	{
+		const Point& p0 = get_key( curve_id ).control;
+		const Point& p3 = get_key( curve_id + 1 ).control;
+
+		//  Jump after a constant segment
+		if ( p0.x > start_time && p0.x <= end_time )
+		{
+			add_part( p0.x, p0.y );
+		}
+		if ( get_key( curve_id ).interpolation_mode 
+		  == InterpolationMode::Constant ) continue;
+
+		const float time_diff = p3.x - p0.x;
+		if ( time_diff <= 0.0f ) continue;
+
+		const float min_t = fmaxf( ( start_time - p0.x ) / time_diff, 0.0f );
+		const float max_t = fminf( ( end_time - p0.x ) / time_diff, 1.0f );
+		if ( min_t >= max_t ) continue;
+
+		Point p0_segment, p1, p2, p3_segment;
+		get_segment_points( curve_id, &p0_segment, &p1, &p2, &p3_segment );
+
+		//  Monotonic segments are a single part
+		float ts[3];
+		int ts_count = 0;
+		float turning_ts[2];
+		const int turning_count = _find_segment_turning_points( 
+			curve_id, turning_ts );
+		for ( int i = 0; i < turning_count; i++ )
+		{
+			if ( turning_ts[i] <= min_t || turning_ts[i] >= max_t ) 
+				continue;
+
+			ts[ts_count++] = turning_ts[i];
+		}
+		ts[ts_count++] = max_t;
+
+		for ( int i = 0; i < ts_count; i++ )
+		{
+			add_part( 
+				p0.x + ts[i] * time_diff, 
+				Utils::bezier_interp( 
+					p0_segment.y, p1.y, p2.y, p3_segment.y, ts[i] )
+			);
+		}
+	}
+
+	//  Jump after a constant last segment
+	const Point& last_point = get_key( curves_count ).control;
+	if ( last_point.x > start_time && last_point.x <= end_time )
+	{
+		add_part( last_point.x, last_point.y );
+	}
+
+	return (int)( times->size() - old_size );
+}
+
+float Curve::_solve_segment_by_value( 
+	int curve_id, 
+	float value, 
+	float min_t, 
+	float max_t 
+) const
+{
+	constexpr int MAX_ITERATIONS = 32;
+	constexpr float EPSILON = 1e-7f;
+
+	Point p0, p1, p2, p3;
+	get_segment_points( curve_id, &p0, &p1, &p2, &p3 );
+
+	//  Y-axis polynomial in its power basis
+	float a = -p0.y + 3.0f * p1.y - 3.0f * p2.y + p3.y;
+	float b = 3.0f * p0.y - 6.0f * p1.y + 3.0f * p2.y;
+	float c = 3.0f * ( p1.y - p0.y );
+	float d = p0.y - value;
+
+	//  Orient it so that it is increasing over the interval
+	float min_error = ( ( a * min_t + b ) * min_t + c ) * min_t + d;
+	float max_error = ( ( a * max_t + b ) * max_t + c ) * max_t + d;
+	if ( max_error < min_error )
+	{
+		a = -a, b = -b, c = -c, d = -d;
+		min_error = -min_error, max_error = -max_error;
+	}
+
+	//  Newton's method, starting from the linear guess and falling
+	//  back to bisection whenever it leaves the interval known to 
+	//  contain the root
+	const float range = max_error - min_error;
+	float t = range > 0.0f 
+		? min_t + ( max_t - min_t ) * -min_error / range 
+		: ( min_t + max_t ) * 0.5f;
+	for ( int i = 0; i < MAX_ITERATIONS; i++ )
+	{
+		const float error = ( ( a * t + b ) * t + c ) * t + d;
+		if ( error < 0.0f ) 
+		{
+			min_t = t;
+		}
+		else
+		{
+			max_t = t;
+		}
+
+		const float slope = ( 3.0f * a * t + 2.0f * b ) * t + c;
+		float next_t = t - error / slope;
+		if ( !( next_t > min_t && next_t < max_t ) )
+		{
+			next_t = ( min_t + max_t ) * 0.5f;
+		}
+
+		if ( fabsf( next_t - t ) < EPSILON ) return next_t;
+		t = next_t;
+	}
+
+	return t;
+}
+
+float Curve::_compute_segment_length( int curve_id, int samples_count ) const
+{
+	const CurveKey& k0 = get_key( curve_id );
+	const CurveKey& k1 = get_key( curve_id + 1 );
+
+	switch ( k0.interpolation_mode )
+	{
+		//  The value jumps to the next key without any path
+		case InterpolationMode::Constant:
+			return 0.0f;
+		case InterpolationMode::Linear:
+			return ( k1.control - k0.control ).length();
+		default:
+			break;
+	}
+
+	const Point& p0 = k0.control;
+	const Point  p1 = p0 + k0.right_tangent;
+	const Point& p3 = k1.control;
+	const Point  p2 = p3 + k1.left_tangent;
+
+	//  Sum the distances between samples
+	float length = 0.0f;
+	Point last_point = p0;
+	for ( int i = 1; i <= samples_count; i++ )
+	{
+		const float t = (float)i / samples_count;
+		const Point point = Utils::bezier_interp( p0, p1, p2, p3, t );
+
+		length += ( point - last_point ).length();
+		last_point = point;
+	}
+
+	return length;
+}
+
+void Curve::_evaluate_by_percent( float t, Point* points, int order ) const
+{
+	int first_key_id, last_key_id;
+	find_evaluation_keys_id_by_percent( 
+		&first_key_id, &last_key_id, t );
+
+	const CurveKey& k0 = get_key( first_key_id );
+	const CurveKey& k1 = get_key( last_key_id );
+
+	const Point& p0 = k0.control;
+	const Point& p3 = k1.control;
+
+	//  Derivatives relative to the whole curve percent are scaled
+	//  by the number of segments
+	const float scale = (float)get_curves_count();
+
+	switch ( k0.interpolation_mode )
+	{
+		case InterpolationMode::Constant:
+			points[0] = t < 1.0f ? p0 : p3;
+			if ( order >= 1 ) points[1] = Point();
+			if ( order >= 2 ) points[2] = Point();
+			return;
+		case InterpolationMode::Linear:
+			points[0] = p0 + ( p3 - p0 ) * t;
+			if ( order >= 1 ) points[1] = ( p3 - p0 ) * scale;
+			if ( order >= 2 ) points[2] = Point();
+			return;
+		default:
+			break;
+	}
+
+	const Point p1 = p0 + k0.right_tangent;
+	const Point p2 = p3 + k1.left_tangent;
+
+	points[0] = Utils::bezier_interp( p0, p1, p2, p3, t );
+	if ( order >= 1 )
+	{
+		points[1] = Utils::bezier_derivative( p0, p1, p2, p3, t ) 
+				  * scale;
+	}
+	if ( order >= 2 )
+	{
+		points[2] = Utils::bezier_second_derivative( p0, p1, p2, p3, t ) 
+				  * ( scale * scale );
+	}
+}
+
+void Curve::_evaluate_by_time( float time, float* values, int order ) const
+{
+	if ( order >= 1 ) values[1] = 0.0f;
+	if ( order >= 2 ) values[2] = 0.0f;
+
+	//  Bound evaluation to first & last points, where the curve
+	//  is flat
+	const Point& first_point = get_key( 0 ).control;
+	const Point& last_point = get_key( get_keys_count() - 1 ).control;
+	if ( time <= first_point.x )
+	{
+		values[0] = first_point.y;
+		return;
+	}
+	if ( time >= last_point.x )
+	{
+		values[0] = last_point.y;
+		return;
+	}
+
+	//  Find evaluation points by time
+	int first_key_id, last_key_id;
+	find_evaluation_keys_id_by_time( 
+		&first_key_id, 
+		&last_key_id, 
+		time 
+	);
+
+	const CurveKey& k0 = get_key( first_key_id );
+	const CurveKey& k1 = get_key( last_key_id );
+
+	const Point& p0 = k0.control;
+	const Point& p3 = k1.control;
+
+	const float time_diff = p3.x - p0.x;
+	if ( time_diff <= 0.0f 
+	  || k0.interpolation_mode == InterpolationMode::Constant )
+	{
+		values[0] = p0.y;
+		return;
+	}
+
+	const float inv_time_diff = 1.0f / time_diff;
+	const float t = ( time - p0.x ) * inv_time_diff;
+
+	if ( k0.interpolation_mode == InterpolationMode::Linear )
+	{
+		values[0] = p0.y + ( p3.y - p0.y ) * t;
+		if ( order >= 1 ) values[1] = ( p3.y - p0.y ) * inv_time_diff;
+		return;
+	}
+
+	const float y1 = p0.y + k0.right_tangent.y;
+	const float y2 = p3.y + k1.left_tangent.y;
+
+	values[0] = Utils::bezier_interp( p0.y, y1, y2, p3.y, t );
+	if ( order >= 1 )
+	{
+		values[1] = Utils::bezier_derivative( p0.y, y1, y2, p3.y, t ) 
+				  * inv_time_diff;
+	}
+	if ( order >= 2 )
+	{
+		values[2] = Utils::bezier_second_derivative( p0.y, y1, y2, p3.y, t ) 
+				  * ( inv_time_diff * inv_time_diff );
+	}
+}
+
+float Curve::integrate( float start_time, float end_time )
+{
+	if ( _is_segments_cache_dirty )
+	{
+		update_segments_cache();
+	}
+
+	return _integrate_to( end_time ) - _integrate_to( start_time );
+}
+
+float Curve::integrate( float start_time, float end_time ) const
+{
+	//  Segments have been added or removed since the last update
+	if ( (int)_prefix_integrals.size() != get_curves_count() + 1 )
+		return 0.0f;
+
+	return _integrate_to( end_time ) - _integrate_to( start_time );
+}
+
+float Curve::_integrate_to( float time ) const
+{
+	//  Outside of the keys, the curve is constant
+	const Point& first_point = get_key( 0 ).control;
+	const Point& last_point = get_key( get_keys_count() - 1 ).control;
+	if ( time <= first_point.x ) 
+		return ( time - first_point.x ) * first_point.y;
+	if ( time >= last_point.x ) 
+		return _prefix_integrals.back() 
+			 + ( time - last_point.x ) * last_point.y;
+
+	//  Find evaluation points by time
+	int first_key_id, last_key_id;
+	find_evaluation_keys_id_by_time( 
+		&first_key_id, 
+		&last_key_id, 
+		time 
+	);
+
+	const float time_diff = get_key( last_key_id ).control.x 
+						  - get_key( first_key_id ).control.x;
+	if ( time_diff <= 0.0f ) return _prefix_integrals[first_key_id];
+
+	const float t = ( time - get_key( first_key_id ).control.x ) / time_diff;
+	return _prefix_integrals[first_key_id] 
+		 + _integrate_segment( first_key_id, t );
+}
+
+float Curve::_integrate_segment( int curve_id, float t ) const
+{
+	Point p0, p1, p2, p3;
+	get_segment_points( curve_id, &p0, &p1, &p2, &p3 );
+
+	//  Segments without time difference have no area
+	const float time_diff = get_key( curve_id + 1 ).control.x - p0.x;
+	if ( time_diff <= 0.0f ) return 0.0f;
+
+	//  Integrate the Y-axis polynomial in its power basis
+	const float a = -p0.y + 3.0f * p1.y - 3.0f * p2.y + p3.y;
+	const float b = 3.0f * p0.y - 6.0f * p1.y + 3.0f * p2.y;
+	const float c = 3.0f * ( p1.y - p0.y );
+	const float d = p0.y;
+
+	const float integral = ( ( ( a * 0.25f * t + b / 3.0f ) * t 
+						   + c * 0.5f ) * t + d ) * t;
+	return integral * time_diff;
+}
+
+int Curve::_find_segment_turning_points( int curve_id, float* ts ) const
+{
+	if ( _segments_cache[curve_id].monotonicity != Monotonicity::None ) 
+		return 0;
+
+	Point p0, p1, p2, p3;
+	get_segment_points( curve_id, &p0, &p1, &p2, &p3 );
+
+	//  Roots of the Y-axis derivative, same as for the bounds
+	const float d0 = p1.y - p0.y;
+	const float d1 = p2.y - p1.y;
+	const float d2 = p3.y - p2.y;
+
+	float roots[2];
+	const int roots_count = Utils::solve_quadratic( 
+		d0 - d1 * 2.0f + d2, 
+		( d1 - d0 ) * 2.0f, 
+		d0, 
+		roots 
+	);
+
+	int count = 0;
+	for ( int i = 0; i < roots_count; i++ )
+	{
+		if ( roots[i] <= 0.0f || roots[i] >= 1.0f ) continue;
+		ts[count++] = roots[i];
+	}
+
+	if ( count == 2 && ts[0] > ts[1] ) 
+	{
+		std::swap( ts[0], ts[1] );
+	}
+
+	return count;
 }
@@ -2,18 +2,6 @@
 
 using namespace curve_x;
 
-CurveKey::CurveKey( 
-	const Point& control, 
-	const Point& left_tangent, 
-	const Point& right_tangent, 
-	TangentMode tangent_mode 
-)
-	: control( control ),
-	  left_tangent( left_tangent ),
-	  right_tangent( right_tangent ),
-	  tangent_mode( tangent_mode )
-{}
-
 void CurveKey::set_left_tangent( const Point& point )
 {
 	_set_tangent( point, &left_tangent, &right_tangent );
@@ -0,0 +1,320 @@
+#include <curve-x/multi-curve.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace curve_x;
+
+MultiCurve::MultiCurve( int channels_count )
+	: _channels_count( channels_count )
+{}
+
+MultiCurve::MultiCurve( const std::vector<Curve>& curves )
+	: _channels_count( (int)curves.size() )
+{
+	if ( curves.empty() ) return;
+
+	//  Ensure all curves share the same keys times & modes
+	const Curve& first_curve = curves[0];
+	const int keys_count = first_curve.get_keys_count();
+	for ( const Curve& curve : curves )
+	{
+		if ( curve.get_keys_count() != keys_count )
+		{
+			throw std::invalid_argument(
+				"Expected curves with the same keys count!"
+			);
+		}
+
+		for ( int key_id = 0; key_id < keys_count; key_id++ )
+		{
+			const CurveKey& key = curve.get_key( key_id );
+			const CurveKey& first_key = first_curve.get_key( key_id );
+			if ( key.control.x != first_key.control.x
+			  || key.tangent_mode != first_key.tangent_mode
+			  || key.interpolation_mode != first_key.interpolation_mode )
+			{
+				throw std::invalid_argument(
+					"Expected curves with the same keys times and modes!"
+				);
+			}
+		}
+	}
+
+	//  Copy keys data
+	std::vector<float> values( _channels_count );
+	std::vector<Point> left_tangents( _channels_count );
+	std::vector<Point> right_tangents( _channels_count );
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		for ( int channel = 0; channel < _channels_count; channel++ )
+		{
+			const CurveKey& key = curves[channel].get_key( key_id );
+			values[channel] = key.control.y;
+			left_tangents[channel] = key.left_tangent;
+			right_tangents[channel] = key.right_tangent;
+		}
+
+		const CurveKey& first_key = first_curve.get_key( key_id );
+		add_key(
+			first_key.control.x,
+			values.data(),
+			left_tangents.data(),
+			right_tangents.data(),
+			first_key.tangent_mode,
+			first_key.interpolation_mode
+		);
+	}
+}
+
+void MultiCurve::evaluate_by_time( float time, float* values ) const
+{
+	const int keys_count = get_keys_count();
+	const float* first_values = _values.data();
+	const float* last_values = first_values
+		+ ( keys_count - 1 ) * _channels_count;
+
+	//  Bound evaluation to first & last keys
+	if ( time <= _times[0] )
+	{
+		std::copy( first_values, first_values + _channels_count, values );
+		return;
+	}
+	if ( time >= _times[keys_count - 1] )
+	{
+		std::copy( last_values, last_values + _channels_count, values );
+		return;
+	}
+
+	//  Find evaluation keys, once for all channels
+	int first_key_id, last_key_id;
+	find_evaluation_keys_id_by_time(
+		&first_key_id,
+		&last_key_id,
+		time
+	);
+
+	const int offset0 = first_key_id * _channels_count;
+	const int offset1 = last_key_id * _channels_count;
+	const float* v0 = _values.data() + offset0;
+	const float* v3 = _values.data() + offset1;
+
+	//  Compute time difference
+	const float time_diff = _times[last_key_id] - _times[first_key_id];
+	if ( time_diff <= 0.0f )
+	{
+		std::copy( v0, v0 + _channels_count, values );
+		return;
+	}
+
+	const float t = ( time - _times[first_key_id] ) / time_diff;
+	switch ( _interpolation_modes[first_key_id] )
+	{
+		case InterpolationMode::Constant:
+			std::copy( v0, v0 + _channels_count, values );
+			return;
+		case InterpolationMode::Linear:
+			for ( int channel = 0; channel < _channels_count; channel++ )
+			{
+				values[channel] = v0[channel] 
+								+ ( v3[channel] - v0[channel] ) * t;
+			}
+			return;
+		default:
+			break;
+	}
+
+	//  Compute the Bernstein weights once for all channels
+	const float it = 1.0f - t;
+	const float w0 = it * it * it;
+	const float w1 = 3.0f * it * it * t;
+	const float w2 = 3.0f * it * t * t;
+	const float w3 = t * t * t;
+
+	//  Interpolate all channels, this loop only reads contiguous
+	//  arrays so that it can be vectorized by the compiler
+	const float* t1 = _right_tangents_y.data() + offset0;
+	const float* t2 = _left_tangents_y.data() + offset1;
+	for ( int channel = 0; channel < _channels_count; channel++ )
+	{
+		values[channel] = v0[channel] * ( w0 + w1 )
+						+ t1[channel] * w1
+						+ t2[channel] * w2
+						+ v3[channel] * ( w2 + w3 );
+	}
+}
+
+void MultiCurve::add_key(
+	float time,
+	const float* values,
+	const Point* left_tangents,
+	const Point* right_tangents,
+	TangentMode tangent_mode,
+	InterpolationMode interpolation_mode
+)
+{
+	_times.push_back( time );
+	_tangent_modes.push_back( tangent_mode );
+	_interpolation_modes.push_back( interpolation_mode );
+
+	for ( int channel = 0; channel < _channels_count; channel++ )
+	{
+		_values.push_back( values[channel] );
+		_left_tangents_x.push_back( left_tangents[channel].x );
+		_left_tangents_y.push_back( left_tangents[channel].y );
+		_right_tangents_x.push_back( right_tangents[channel].x );
+		_right_tangents_y.push_back( right_tangents[channel].y );
+	}
+}
+
+void MultiCurve::add_key(
+	float time,
+	const float* values,
+	TangentMode tangent_mode,
+	InterpolationMode interpolation_mode
+)
+{
+	std::vector<Point> left_tangents( _channels_count, { -1.0f, 0.0f } );
+	std::vector<Point> right_tangents( _channels_count, { 1.0f, 0.0f } );
+
+	add_key(
+		time,
+		values,
+		left_tangents.data(),
+		right_tangents.data(),
+		tangent_mode,
+		interpolation_mode
+	);
+}
+
+void MultiCurve::remove_key( int key_id )
+{
+	_times.erase( _times.begin() + key_id );
+	_tangent_modes.erase( _tangent_modes.begin() + key_id );
+	_interpolation_modes.erase( _interpolation_modes.begin() + key_id );
+
+	const int first = key_id * _channels_count;
+	const int last = first + _channels_count;
+	for ( std::vector<float>* data : {
+		&_values,
+		&_left_tangents_x, &_left_tangents_y,
+		&_right_tangents_x, &_right_tangents_y,
+	} )
+	{
+		data->erase( data->begin() + first, data->begin() + last );
+	}
+}
+
+float MultiCurve::get_key_time( int key_id ) const
+{
+	return _times[key_id];
+}
+
+TangentMode MultiCurve::get_tangent_mode( int key_id ) const
+{
+	return _tangent_modes[key_id];
+}
+
+void MultiCurve::set_interpolation_mode( int key_id, InterpolationMode mode )
+{
+	_interpolation_modes[key_id] = mode;
+}
+
+InterpolationMode MultiCurve::get_interpolation_mode( int key_id ) const
+{
+	return _interpolation_modes[key_id];
+}
+
+void MultiCurve::set_value( int key_id, int channel, float value )
+{
+	_values[key_id * _channels_count + channel] = value;
+}
+
+float MultiCurve::get_value( int key_id, int channel ) const
+{
+	return _values[key_id * _channels_count + channel];
+}
+
+void MultiCurve::set_tangents(
+	int key_id,
+	int channel,
+	const Point& left_tangent,
+	const Point& right_tangent
+)
+{
+	const int id = key_id * _channels_count + channel;
+	_left_tangents_x[id] = left_tangent.x;
+	_left_tangents_y[id] = left_tangent.y;
+	_right_tangents_x[id] = right_tangent.x;
+	_right_tangents_y[id] = right_tangent.y;
+}
+
+Point MultiCurve::get_left_tangent( int key_id, int channel ) const
+{
+	const int id = key_id * _channels_count + channel;
+	return Point( _left_tangents_x[id], _left_tangents_y[id] );
+}
+
+Point MultiCurve::get_right_tangent( int key_id, int channel ) const
+{
+	const int id = key_id * _channels_count + channel;
+	return Point( _right_tangents_x[id], _right_tangents_y[id] );
+}
+
+Curve MultiCurve::extract_channel( int channel ) const
+{
+	const int keys_count = get_keys_count();
+
+	Curve curve;
+	curve.reserve( keys_count );
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		curve.emplace_key(
+			Point( _times[key_id], get_value( key_id, channel ) ),
+			get_left_tangent( key_id, channel ),
+			get_right_tangent( key_id, channel ),
+			_tangent_modes[key_id],
+			_interpolation_modes[key_id]
+		);
+	}
+
+	return curve;
+}
+
+void MultiCurve::find_evaluation_keys_id_by_time(
+	int* first_key_id,
+	int* last_key_id,
+	float time
+) const
+{
+	//  Find the first key strictly after the given time, ignoring
+	//  the first and last keys, same as 'Curve'
+	auto itr = std::upper_bound(
+		_times.begin() + 1,
+		_times.end() - 1,
+		time
+	);
+
+	*last_key_id = (int)( itr - _times.begin() );
+	*first_key_id = *last_key_id - 1;
+}
+
+bool MultiCurve::is_valid() const
+{
+	return get_keys_count() > 1;
+}
+
+int MultiCurve::get_channels_count() const
+{
+	return _channels_count;
+}
+
+int MultiCurve::get_keys_count() const
+{
+	return (int)_times.size();
+}
+
+int MultiCurve::get_curves_count() const
+{
+	return get_keys_count() - 1;
+}
@@ -0,0 +1,323 @@
+#include <curve-x/quantized-curve.h>
+
+#include <algorithm>
+#include <cassert>
+
+#include <curve-x/utils.h>
+
+using namespace curve_x;
+
+/*
+ * Largest quantized values, for unsigned and signed quantities.
+ */
+static constexpr float UNSIGNED_SCALE = 65535.0f;
+static constexpr float SIGNED_SCALE = 32767.0f;
+
+/*
+ * Number of samples per segment used to measure the errors.
+ */
+static constexpr int ERROR_SAMPLES_COUNT = 64;
+
+static uint16_t quantize_unsigned( float value, float min, float max )
+{
+	if ( max <= min ) return 0;
+
+	const float ratio = ( value - min ) / ( max - min );
+	return (uint16_t)lroundf( fminf( fmaxf( ratio, 0.0f ), 1.0f ) * UNSIGNED_SCALE );
+}
+
+static float dequantize_unsigned( uint16_t value, float min, float max )
+{
+	return min + ( max - min ) * ( value / UNSIGNED_SCALE );
+}
+
+static int16_t quantize_signed( float value, float scale )
+{
+	if ( scale <= 0.0f ) return 0;
+
+	const float ratio = value / scale;
+	return (int16_t)lroundf( fminf( fmaxf( ratio, -1.0f ), 1.0f ) * SIGNED_SCALE );
+}
+
+static float dequantize_signed( int16_t value, float scale )
+{
+	return scale * ( value / SIGNED_SCALE );
+}
+
+QuantizedCurve::QuantizedCurve()
+{}
+
+QuantizedCurve::QuantizedCurve( const Curve& curve )
+{
+	const int keys_count = curve.get_keys_count();
+
+	//  Find the ranges of the control points and of the tangents
+	_extrems = { INFINITY, -INFINITY, INFINITY, -INFINITY };
+	_tangents_scale = Point( 0.0f, 0.0f );
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		const CurveKey& key = curve.get_key( key_id );
+		_extrems.min_x = fminf( _extrems.min_x, key.control.x );
+		_extrems.max_x = fmaxf( _extrems.max_x, key.control.x );
+		_extrems.min_y = fminf( _extrems.min_y, key.control.y );
+		_extrems.max_y = fmaxf( _extrems.max_y, key.control.y );
+
+		for ( const Point& tangent : { key.left_tangent, key.right_tangent } )
+		{
+			_tangents_scale.x = fmaxf( _tangents_scale.x, fabsf( tangent.x ) );
+			_tangents_scale.y = fmaxf( _tangents_scale.y, fabsf( tangent.y ) );
+		}
+	}
+
+	//  Quantize keys
+	_times.reserve( keys_count );
+	_values.reserve( keys_count );
+	_tangents.reserve( keys_count * 4 );
+	_modes.reserve( keys_count );
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		const CurveKey& key = curve.get_key( key_id );
+		_times.push_back( quantize_unsigned(
+			key.control.x, _extrems.min_x, _extrems.max_x ) );
+		_values.push_back( quantize_unsigned(
+			key.control.y, _extrems.min_y, _extrems.max_y ) );
+
+		_tangents.push_back( quantize_signed( key.left_tangent.x, _tangents_scale.x ) );
+		_tangents.push_back( quantize_signed( key.left_tangent.y, _tangents_scale.y ) );
+		_tangents.push_back( quantize_signed( key.right_tangent.x, _tangents_scale.x ) );
+		_tangents.push_back( quantize_signed( key.right_tangent.y, _tangents_scale.y ) );
+
+		_modes.push_back( (uint8_t)(
+			(int)key.tangent_mode | (int)key.interpolation_mode << 4 ) );
+	}
+
+	_measure_errors( curve );
+}
+
+Point QuantizedCurve::evaluate_by_percent( float t ) const
+{
+	assert( is_valid() );
+
+	const int curves_count = get_curves_count();
+
+	//  The end of the curve is always the last point, even for a
+	//  constant last segment
+	if ( t >= 1.0f ) return decode_key( curves_count ).control;
+
+	t = fmaxf( t, 0.0f ) * curves_count;
+	const int curve_id = (int)t;
+	t -= (float)curve_id;
+
+	Point p0, p1, p2, p3;
+	decode_segment( curve_id, &p0, &p1, &p2, &p3 );
+	return Utils::bezier_interp( p0, p1, p2, p3, t );
+}
+
+float QuantizedCurve::evaluate_by_time( float time ) const
+{
+	assert( is_valid() );
+
+	//  Compare times in the quantized scale, without decoding keys
+	const float range = _extrems.max_x - _extrems.min_x;
+	const float quantized_time = range > 0.0f
+		? ( time - _extrems.min_x ) / range * UNSIGNED_SCALE
+		: 0.0f;
+
+	//  Bound evaluation to first & last points
+	if ( quantized_time <= _times.front() )
+		return dequantize_unsigned( _values.front(), _extrems.min_y, _extrems.max_y );
+	if ( quantized_time >= _times.back() )
+		return dequantize_unsigned( _values.back(), _extrems.min_y, _extrems.max_y );
+
+	const int curve_id = find_segment_id_by_time( time );
+
+	Point p0, p1, p2, p3;
+	decode_segment( curve_id, &p0, &p1, &p2, &p3 );
+
+	const float start_time = _decode_time( curve_id );
+	const float time_diff = _decode_time( curve_id + 1 ) - start_time;
+	if ( time_diff <= 0.0f ) return p0.y;
+
+	const float t = ( quantized_time - start_time ) / time_diff;
+	return Utils::bezier_interp( p0.y, p1.y, p2.y, p3.y, t );
+}
+
+CurveKey QuantizedCurve::decode_key( int key_id ) const
+{
+	assert( key_id >= 0 && key_id < get_keys_count() );
+
+	const int16_t* tangents = &_tangents[key_id * 4];
+	return CurveKey(
+		Point(
+			dequantize_unsigned( _times[key_id], _extrems.min_x, _extrems.max_x ),
+			dequantize_unsigned( _values[key_id], _extrems.min_y, _extrems.max_y )
+		),
+		Point(
+			dequantize_signed( tangents[0], _tangents_scale.x ),
+			dequantize_signed( tangents[1], _tangents_scale.y )
+		),
+		Point(
+			dequantize_signed( tangents[2], _tangents_scale.x ),
+			dequantize_signed( tangents[3], _tangents_scale.y )
+		),
+		(TangentMode)( _modes[key_id] & 0x0F ),
+		(InterpolationMode)( _modes[key_id] >> 4 )
+	);
+}
+
+void QuantizedCurve::decode_segment(
+	int curve_id,
+	Point* p0, Point* p1,
+	Point* p2, Point* p3
+) const
+{
+	assert( curve_id >= 0 && curve_id < get_curves_count() );
+
+	const CurveKey k0 = decode_key( curve_id );
+	const CurveKey k1 = decode_key( curve_id + 1 );
+
+	*p0 = k0.control;
+	*p3 = k1.control;
+
+	switch ( k0.interpolation_mode )
+	{
+		case InterpolationMode::Constant:
+			*p1 = *p2 = *p3 = k0.control;
+			break;
+		case InterpolationMode::Linear:
+			*p1 = k0.control + ( k1.control - k0.control ) / 3.0f;
+			*p2 = k1.control + ( k0.control - k1.control ) / 3.0f;
+			break;
+		default:
+			*p1 = k0.control + k0.right_tangent;
+			*p2 = k1.control + k1.left_tangent;
+			break;
+	}
+}
+
+Curve QuantizedCurve::to_curve() const
+{
+	const int keys_count = get_keys_count();
+
+	Curve curve;
+	curve.reserve( keys_count );
+	for ( int key_id = 0; key_id < keys_count; key_id++ )
+	{
+		curve.add_key( decode_key( key_id ) );
+	}
+
+	return curve;
+}
+
+int QuantizedCurve::find_segment_id_by_time( float time ) const
+{
+	assert( is_valid() );
+
+	const float range = _extrems.max_x - _extrems.min_x;
+	const float quantized_time = range > 0.0f
+		? ( time - _extrems.min_x ) / range * UNSIGNED_SCALE
+		: 0.0f;
+
+	//  Find the first key strictly after the given time, ignoring
+	//  the first and last keys which are handled by bounds
+	auto itr = std::upper_bound(
+		_times.begin() + 1,
+		_times.end() - 1,
+		quantized_time,
+		[]( float value, uint16_t key_time ) {
+			return value < (float)key_time;
+		}
+	);
+
+	return (int)( itr - _times.begin() ) - 1;
+}
+
+float QuantizedCurve::get_time_error() const
+{
+	return _time_error;
+}
+
+float QuantizedCurve::get_geometry_error() const
+{
+	return _geometry_error;
+}
+
+size_t QuantizedCurve::get_memory_usage() const
+{
+	return sizeof( QuantizedCurve )
+		 + _times.capacity() * sizeof( uint16_t )
+		 + _values.capacity() * sizeof( uint16_t )
+		 + _tangents.capacity() * sizeof( int16_t )
+		 + _modes.capacity() * sizeof( uint8_t );
+}
+
+size_t QuantizedCurve::get_memory_usage( const Curve& curve )
+{
+	//  The segments cache holds bounds and an integral per segment,
+	//  and a prefix integral per key
+	const size_t curves_count = (size_t)std::max( 0, curve.get_curves_count() );
+	return sizeof( Curve )
+		 + curve.get_capacity() * sizeof( CurveKey )
+		 + curves_count * sizeof( CurveSegmentCache )
+		 + ( curves_count + 1 ) * sizeof( float );
+}
+
+int QuantizedCurve::get_keys_count() const
+{
+	return (int)_times.size();
+}
+
+int QuantizedCurve::get_curves_count() const
+{
+	return std::max( 0, get_keys_count() - 1 );
+}
+
+bool QuantizedCurve::is_valid() const
+{
+	return get_keys_count() > 1;
+}
+
+float QuantizedCurve::_decode_time( int key_id ) const
+{
+	return (float)_times[key_id];
+}
+
+void QuantizedCurve::_measure_errors( const Curve& curve )
+{
+	_time_error = 0.0f;
+	_geometry_error = 0.0f;
+	if ( !is_valid() ) return;
+
+	const int curves_count = get_curves_count();
+	for ( int curve_id = 0; curve_id < curves_count; curve_id++ )
+	{
+		Point original_points[4], points[4];
+		curve.get_segment_points(
+			curve_id,
+			&original_points[0], &original_points[1],
+			&original_points[2], &original_points[3]
+		);
+		decode_segment( curve_id, &points[0], &points[1], &points[2], &points[3] );
+
+		const float start_time = curve.get_key( curve_id ).control.x;
+		const float end_time = curve.get_key( curve_id + 1 ).control.x;
+		for ( int i = 0; i <= ERROR_SAMPLES_COUNT; i++ )
+		{
+			const float t = (float)i / ERROR_SAMPLES_COUNT;
+
+			//  Compare points at the same ratio, which bounds the
+			//  distance between both curves
+			const Point original_point = Utils::bezier_interp(
+				original_points[0], original_points[1],
+				original_points[2], original_points[3], t );
+			const Point point = Utils::bezier_interp(
+				points[0], points[1], points[2], points[3], t );
+			_geometry_error = fmaxf( _geometry_error,
+				( point - original_point ).length() );
+
+			const float time = start_time + ( end_time - start_time ) * t;
+			_time_error = fmaxf( _time_error,
+				fabsf( evaluate_by_time( time ) - curve.evaluate_by_time( time ) ) );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include <curve-x/curve.h>
+
+#include <chrono>
+#include <cstdio>
+
+/*
+ * Benchmark of the evaluation and lookup methods.
+ *
+ * This file is compiled twice: once against the library and once
+ * with 'CURVE_X_INLINE_HOT_PATHS' defined, so that both executables
+ * can be compared. Build in release for meaningful results.
+ */
+
+#ifdef CURVE_X_INLINE_HOT_PATHS
+static const char* MODE_NAME = "inline";
+#else
+static const char* MODE_NAME = "library";
+#endif
+
+constexpr int KEYS_COUNT = 64;
+constexpr int ITERATIONS = 10000000;
+
+template<typename Function>
+static void benchmark( const char* name, Function function )
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	auto start = clock::now();
+	float sum = function();
+	auto end = clock::now();
+
+	double ns = std::chrono::duration<double, std::nano>( end - start ).count();
+	//  Printing the sum prevents the compiler from removing the loop
+	printf( "- %s: %.2f ns/call (sum=%f)\n", name, ns / ITERATIONS, sum );
+}
+
+int main()
+{
+	printf( "Curve benchmark (%s)\n\n", MODE_NAME );
+
+	//  Build a zig-zag curve
+	curve_x::Curve curve;
+	for ( int key_id = 0; key_id < KEYS_COUNT; key_id++ )
+	{
+		curve.add_key( curve_x::CurveKey(
+			{ (float)key_id, (float)( key_id % 2 ) },
+			{ -0.3f, -0.2f },
+			{ 0.3f, 0.2f }
+		) );
+	}
+	curve.compute_length();
+
+	const float max_time = (float)KEYS_COUNT;
+	const float time_step = max_time / ITERATIONS;
+	const float percent_step = 1.0f / ITERATIONS;
+
+	benchmark( "evaluate_by_time", [&]()
+	{
+		float sum = 0.0f;
+		for ( int i = 0; i < ITERATIONS; i++ )
+		{
+			sum += curve.evaluate_by_time( i * time_step );
+		}
+		return sum;
+	} );
+
+	benchmark( "evaluate_by_percent", [&]()
+	{
+		float sum = 0.0f;
+		for ( int i = 0; i < ITERATIONS; i++ )
+		{
+			sum += curve.evaluate_by_percent( i * percent_step ).y;
+		}
+		return sum;
+	} );
+
+	benchmark( "get_key", [&]()
+	{
+		float sum = 0.0f;
+		for ( int i = 0; i < ITERATIONS; i++ )
+		{
+			sum += curve.get_key( i % KEYS_COUNT ).control.y;
+		}
+		return sum;
+	} );
+}
@@ -0,0 +1,87 @@
+#include <curve-x/curve-kernels.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/*
+ * Benchmark of the batch kernels, for each SIMD level supported
+ * by the CPU. Build in release for meaningful results.
+ */
+
+constexpr int KEYS_COUNT = 4096;
+constexpr int SAMPLES_COUNT = 1 << 16;
+constexpr int ITERATIONS = 100;
+
+template<typename Function>
+static void benchmark( const char* name, int count, Function function )
+{
+	using clock = std::chrono::high_resolution_clock;
+
+	auto start = clock::now();
+	float sum = 0.0f;
+	for ( int i = 0; i < ITERATIONS; i++ )
+	{
+		sum += function();
+	}
+	auto end = clock::now();
+
+	double ns = std::chrono::duration<double, std::nano>( end - start ).count();
+	//  Printing the sum prevents the compiler from removing the loop
+	printf( "- %s: %.2f ns/element (sum=%f)\n",
+		name, ns / ( (double)ITERATIONS * count ), sum );
+}
+
+int main()
+{
+	using namespace curve_x;
+
+	//  Build a zig-zag curve
+	Curve curve;
+	for ( int key_id = 0; key_id < KEYS_COUNT; key_id++ )
+	{
+		curve.add_key( CurveKey(
+			{ (float)key_id, (float)( key_id % 2 ) },
+			{ -0.3f, -0.2f },
+			{ 0.3f, 0.2f }
+		) );
+	}
+	const CompiledCurve compiled_curve = curve.compile();
+
+	std::vector<float> times( SAMPLES_COUNT );
+	for ( int i = 0; i < SAMPLES_COUNT; i++ )
+	{
+		times[i] = (float)i / SAMPLES_COUNT * KEYS_COUNT;
+	}
+	std::vector<float> values( SAMPLES_COUNT );
+	std::vector<Point> points( SAMPLES_COUNT );
+
+	printf( "Detected: %s\n", CurveKernels::get_simd_level_name(
+		CurveKernels::detect_simd_level() ) );
+
+	for ( int level = 0; level <= (int)SimdLevel::AVX512; level++ )
+	{
+		if ( !CurveKernels::set_simd_level( (SimdLevel)level ) ) break;
+
+		printf( "\nKernels (%s)\n", CurveKernels::get_simd_level_name(
+			(SimdLevel)level ) );
+
+		benchmark( "evaluate_by_time", SAMPLES_COUNT, [&]()
+		{
+			compiled_curve.evaluate_by_time(
+				times.data(), values.data(), SAMPLES_COUNT );
+			return values[SAMPLES_COUNT / 3];
+		} );
+
+		benchmark( "tessellate", SAMPLES_COUNT, [&]()
+		{
+			compiled_curve.tessellate( SAMPLES_COUNT, points.data() );
+			return points[SAMPLES_COUNT / 3].y;
+		} );
+
+		benchmark( "compute_length", KEYS_COUNT - 1, [&]()
+		{
+			return CurveKernels::compute_length( compiled_curve );
+		} );
+	}
+}
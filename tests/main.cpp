@@ -1,7 +1,1463 @@
 #include <curve-x/curve.h>
 #include <curve-x/curve-serializer.h>
+#include <curve-x/compiled-curve.h>
+#include <curve-x/fixed-curve.h>
+#include <curve-x/curve-intersector.h>
+#include <curve-x/multi-curve.h>
+#include <curve-x/curve-stroker.h>
+#include <curve-x/curve-loader.h>
+#include <curve-x/curve-fitter.h>
+#include <curve-x/curve-kernels.h>
+#include <curve-x/curve-patch.h>
+#include <curve-x/curve-blender.h>
+#include <curve-x/quantized-curve.h>
+#include <curve-x/curve-track-scheduler.h>
 
+#include <algorithm>
 #include <assert.h>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+/*
+ * Returns whenever calling the given function throws an
+ * 'std::invalid_argument'.
+ */
+template<typename Function>
+static bool is_throwing( Function function )
+{
+	try
+	{
+		function();
+	}
+	catch ( const std::invalid_argument& )
+	{
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Un-serialize curves from the different versions and line endings
+ * of the format, from strings and from streams.
+ */
+static void test_unserialize()
+{
+	using namespace curve_x;
+
+	CurveSerializer serializer;
+
+	//  Version 1 has no interpolation modes, keys are cubic
+	const std::string data_v1 = 
+		"version:1\n"
+		"0:x=0.000000;y=0.000000,x=-1.000000;y=0.000000,x=1.000000;y=0.000000,0\n"
+		"1:x=1.000000;y=2.000000,x=-0.500000;y=-1.000000,x=0.500000;y=1.000000,2\n";
+	const Curve curve_v1 = serializer.unserialize( data_v1 );
+	assert( curve_v1.get_keys_count() == 2 );
+	assert( curve_v1.get_key( 0 ).interpolation_mode == InterpolationMode::Cubic );
+	assert( curve_v1.get_key( 1 ).tangent_mode == TangentMode::Broken );
+	assert( curve_v1.get_key( 1 ).control == Point( 1.0f, 2.0f ) );
+	assert( curve_v1.get_key( 1 ).left_tangent == Point( -0.5f, -1.0f ) );
+
+	//  Version 2 appends the interpolation mode
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 1.0f } ) );
+	curve.add_key( CurveKey( { 1.0f, -2.5f }, { -0.25f, 0.5f }, { 0.75f, 0.0f } ) );
+	curve.add_key( CurveKey( { 3.0f, 4.0f } ) );
+	curve.set_interpolation_mode( 0, InterpolationMode::Linear );
+	curve.set_interpolation_mode( 1, InterpolationMode::Constant );
+
+	const std::string data = serializer.serialize( curve );
+	auto assert_same_keys = [&curve]( const Curve& other )
+	{
+		assert( other.get_keys_count() == curve.get_keys_count() );
+		for ( int key_id = 0; key_id < curve.get_keys_count(); key_id++ )
+		{
+			const CurveKey& key = curve.get_key( key_id );
+			const CurveKey& other_key = other.get_key( key_id );
+			assert( key.control == other_key.control );
+			assert( key.left_tangent == other_key.left_tangent );
+			assert( key.right_tangent == other_key.right_tangent );
+			assert( key.tangent_mode == other_key.tangent_mode );
+			assert( key.interpolation_mode == other_key.interpolation_mode );
+		}
+	};
+	assert_same_keys( serializer.unserialize( data ) );
+
+	//  Windows line endings
+	std::string data_crlf;
+	for ( char c : data )
+	{
+		if ( c == '\n' ) data_crlf += '\r';
+		data_crlf += c;
+	}
+	assert_same_keys( serializer.unserialize( data_crlf ) );
+
+	//  Missing new line at the end
+	const std::string data_no_newline = data.substr( 0, data.size() - 1 );
+	assert_same_keys( serializer.unserialize( data_no_newline ) );
+	{
+		std::istringstream stream( data_no_newline );
+		assert_same_keys( serializer.unserialize( stream ) );
+	}
+
+	//  Key line split across two chunks of a stream, skipping a
+	//  filler line moving it over the chunk boundary
+	const size_t version_end = data.find( '\n' ) + 1;
+	std::string data_split = data.substr( 0, version_end );
+	data_split += std::string( UNSERIALIZE_CHUNK_SIZE - version_end - 10, '#' );
+	data_split += '\n';
+	data_split += data.substr( version_end );
+	{
+		std::istringstream stream( data_split );
+		assert_same_keys( serializer.unserialize( stream ) );
+	}
+	assert_same_keys( serializer.unserialize( data_split ) );
+
+	//  Malformed data
+	const char* invalid_data[] {
+		"0:x=0.000000;y=0.000000,x=-1.000000;y=0.000000,x=1.000000;y=0.000000,0,2\n",
+		"version:\n",
+		"version:2\n0:x=0.000000;y=0.000000,x=-1.000000;y=0.000000\n",
+		"version:2\n0:x=0.000000;y=0.000000,x=-1.000000;y=0.000000,x=1.0;y=\xe9,0,2\n",
+		"version:2\n0:x=0.000000;y=0.000000,x=-1.000000;y=0.000000,x=1.000000;y=0.000000,\n",
+		"version:2\n0:x=0.000000;y=0.000000,x=-1.000000;y=0.000000,x=1.000000;y=0.000000,0\n",
+	};
+	for ( const char* invalid : invalid_data )
+	{
+		const std::string invalid_string = invalid;
+		assert( is_throwing( [&]() { serializer.unserialize( invalid_string ); } ) );
+		assert( is_throwing( [&]() {
+			std::istringstream stream( invalid_string );
+			serializer.unserialize( stream );
+		} ) );
+	}
+}
+
+/*
+ * Load valid, empty, malformed and missing files, whose errors 
+ * must be reported in the results.
+ */
+static void test_loader()
+{
+	using namespace curve_x;
+
+	const std::filesystem::path directory = 
+		std::filesystem::temp_directory_path();
+	const std::string valid_path = ( directory / "curve-x-valid.cvx" ).string();
+	const std::string empty_path = ( directory / "curve-x-empty.cvx" ).string();
+	const std::string invalid_path = ( directory / "curve-x-invalid.cvx" ).string();
+	const std::string missing_path = ( directory / "curve-x-missing.cvx" ).string();
+
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f } ) );
+	curve.add_key( CurveKey( { 1.0f, 1.0f } ) );
+
+	CurveSerializer serializer;
+	std::ofstream( valid_path ) << serializer.serialize( curve );
+	std::ofstream{ empty_path };
+	std::ofstream( invalid_path ) << "version:2\n0:x=0.0;y=\n";
+	std::filesystem::remove( missing_path );
+
+	CurveLoader loader( 2 );
+	auto futures = loader.load( { valid_path, empty_path, invalid_path, missing_path } );
+
+	const CurveLoadResult valid_result = futures[0].get();
+	assert( valid_result.is_loaded && valid_result.error.empty() );
+	assert( valid_result.curve.get_keys_count() == 2 );
+	assert( valid_result.path == valid_path );
+
+	for ( size_t i = 1; i < futures.size(); i++ )
+	{
+		const CurveLoadResult result = futures[i].get();
+		assert( !result.is_loaded && !result.error.empty() );
+		assert( result.curve.get_keys_count() == 0 );
+	}
+
+	loader.wait();
+	assert( loader.get_pending_count() == 0 );
+
+	for ( const std::string& path : { valid_path, empty_path, invalid_path } )
+	{
+		std::filesystem::remove( path );
+	}
+}
+
+/*
+ * Fit curves to dense samples, which must stay within the 
+ * tolerance with fewer keys than samples.
+ */
+static void test_fitter()
+{
+	using namespace curve_x;
+
+	constexpr int SAMPLES_COUNT = 200;
+	constexpr float TOLERANCE = 0.005f;
+
+	std::vector<Point> samples( SAMPLES_COUNT );
+	for ( int i = 0; i < SAMPLES_COUNT; i++ )
+	{
+		const float time = i * 0.05f;
+		samples[i] = Point( time, sinf( time ) );
+	}
+
+	CurveFitter fitter( TOLERANCE );
+	const Curve curve = fitter.fit_by_time( samples.data(), SAMPLES_COUNT );
+	assert( curve.is_valid() && curve.get_keys_count() < SAMPLES_COUNT / 4 );
+	assert( fitter.get_max_error() <= TOLERANCE );
+	for ( const Point& sample : samples )
+	{
+		assert( fabsf( curve.evaluate_by_time( sample.x ) - sample.y ) 
+			<= TOLERANCE * 1.01f );
+	}
+
+	//  Fitting a shape going through the same points
+	const Curve shape = fitter.fit( samples.data(), SAMPLES_COUNT );
+	assert( shape.is_valid() && shape.get_keys_count() < SAMPLES_COUNT / 4 );
+	assert( fitter.get_max_error() <= TOLERANCE );
+}
+
+/*
+ * Build multi-channel curves from curves with mixed interpolation
+ * modes, which must evaluate and serialize like these curves.
+ */
+static void test_multi_curve_modes()
+{
+	using namespace curve_x;
+
+	std::vector<Curve> curves( 2 );
+	for ( int channel = 0; channel < 2; channel++ )
+	{
+		Curve& curve = curves[channel];
+		curve.add_key( CurveKey( { 0.0f, 0.0f + channel } ) );
+		curve.add_key( CurveKey( { 1.0f, 1.0f - channel } ) );
+		curve.add_key( CurveKey( { 2.0f, 0.5f } ) );
+		curve.add_key( CurveKey( { 3.0f, 2.0f } ) );
+		curve.set_interpolation_mode( 0, InterpolationMode::Constant );
+		curve.set_interpolation_mode( 1, InterpolationMode::Linear );
+	}
+
+	const MultiCurve multi_curve( curves );
+	assert( multi_curve.get_interpolation_mode( 0 ) == InterpolationMode::Constant );
+	assert( multi_curve.get_interpolation_mode( 1 ) == InterpolationMode::Linear );
+	assert( multi_curve.get_interpolation_mode( 2 ) == InterpolationMode::Cubic );
+
+	//  The format keeps the modes
+	CurveSerializer serializer;
+	const MultiCurve copy = serializer.unserialize_multi( 
+		serializer.serialize( multi_curve ) );
+	assert( copy.get_interpolation_mode( 0 ) == InterpolationMode::Constant );
+	assert( copy.get_interpolation_mode( 1 ) == InterpolationMode::Linear );
+
+	for ( float time = -0.5f; time <= 3.5f; time += 0.125f )
+	{
+		float values[2], copy_values[2];
+		multi_curve.evaluate_by_time( time, values );
+		copy.evaluate_by_time( time, copy_values );
+
+		for ( int channel = 0; channel < 2; channel++ )
+		{
+			const float value = curves[channel].evaluate_by_time( time );
+			assert( fabsf( values[channel] - value ) < 0.0001f );
+			assert( fabsf( copy_values[channel] - value ) < 0.0001f );
+		}
+	}
+
+	//  Channels can't have different modes
+	curves[1].set_interpolation_mode( 2, InterpolationMode::Linear );
+	assert( is_throwing( [&]() { MultiCurve mixed_curve( curves ); } ) );
+}
+
+/*
+ * Stroke a curve, whose cached stroke must only be reused until
+ * the curve is modified.
+ */
+static void test_stroke_cache()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f } ) );
+	curve.add_key( CurveKey( { 1.0f, 1.0f } ) );
+	curve.add_key( CurveKey( { 2.0f, 0.0f } ) );
+
+	//  Revisions only change with the keys
+	const uint64_t revision = curve.get_revision();
+	assert( curve.get_revision() == revision );
+	assert( Curve( curve ).get_revision() == revision );
+
+	CurveStroker stroker( 0.1f );
+	const std::vector<Point> vertices = stroker.stroke( curve );
+	assert( vertices.size() >= 4 && vertices.size() % 2 == 0 );
+	assert( &stroker.stroke( curve ) == &stroker.stroke( curve ) );
+	assert( stroker.get_cached_strokes_count() == 1 );
+
+	//  The buffer is only written if large enough
+	std::vector<Point> buffer( vertices.size() );
+	assert( stroker.stroke( curve, buffer.data(), 2 ) == (int)vertices.size() );
+	assert( stroker.stroke( curve, buffer.data(), (int)buffer.size() ) 
+		 == (int)vertices.size() );
+	assert( buffer == vertices );
+
+	//  Editing the curve invalidates its stroke
+	curve.set_point( 3, Point( 1.0f, 2.0f ) );
+	assert( curve.get_revision() != revision );
+	assert( stroker.stroke( curve ) != vertices );
+
+	//  Changing the width invalidates all strokes
+	const std::vector<Point> edited_vertices = stroker.stroke( curve );
+	stroker.set_width( 0.2f );
+	assert( stroker.get_cached_strokes_count() == 0 );
+	assert( stroker.stroke( curve ) != edited_vertices );
+
+	stroker.forget( curve );
+	assert( stroker.get_cached_strokes_count() == 0 );
+}
+
+/*
+ * Intersect curves with themselves, whose overlaps must only be
+ * reported by their ends.
+ */
+static void test_intersections()
+{
+	using namespace curve_x;
+
+	//  A straight segment overlaps itself from its start to its end
+	Curve segment;
+	segment.add_key( CurveKey( { 0.0f, 0.0f } ) );
+	segment.add_key( CurveKey( { 1.0f, 1.0f } ) );
+	segment.set_interpolation_mode( 0, InterpolationMode::Linear );
+
+	std::vector<CurveIntersection> intersections;
+	assert( CurveIntersector::intersect_curves( 
+		segment, segment, &intersections ) == 2 );
+	assert( intersections[0].is_overlap && intersections[1].is_overlap );
+	assert( intersections[0].t == 0.0f && intersections[1].t == 1.0f );
+
+	//  Overlaps continuing across keys are merged into one range
+	Curve curve;
+	for ( int key_id = 0; key_id < 20; key_id++ )
+	{
+		curve.add_key( CurveKey( 
+			{ (float)key_id, (float)( key_id % 3 ) },
+			{ -0.3f, 0.2f },
+			{ 0.3f, -0.2f }
+		) );
+	}
+	const Curve copy = curve;
+
+	intersections.clear();
+	assert( CurveIntersector::intersect_curves( 
+		curve, copy, &intersections ) == 2 );
+	assert( intersections[0].is_overlap && intersections[1].is_overlap );
+
+	//  Collinear segments only overlap on their shared part
+	Curve other_segment;
+	other_segment.add_key( CurveKey( { 0.5f, 0.5f } ) );
+	other_segment.add_key( CurveKey( { 2.0f, 2.0f } ) );
+	other_segment.set_interpolation_mode( 0, InterpolationMode::Linear );
+
+	intersections.clear();
+	assert( CurveIntersector::intersect_curves( 
+		segment, other_segment, &intersections ) == 2 );
+	assert( fabsf( intersections[0].t - 0.5f ) < 0.001f );
+	assert( fabsf( intersections[1].other_t - 1.0f / 3.0f ) < 0.001f );
+
+	//  Crossing curves still intersect once
+	Curve crossing;
+	crossing.add_key( CurveKey( { 0.0f, 1.0f } ) );
+	crossing.add_key( CurveKey( { 1.0f, 0.0f } ) );
+	crossing.set_interpolation_mode( 0, InterpolationMode::Linear );
+
+	intersections.clear();
+	assert( CurveIntersector::intersect_curves( 
+		segment, crossing, &intersections ) == 1 );
+	assert( !intersections[0].is_overlap );
+	assert( ( intersections[0].point - curve_x::Point( 0.5f, 0.5f ) ).length() 
+		< 0.001f );
+}
+
+/*
+ * Run the kernels at each level supported by the CPU, which must
+ * match the scalar implementation, with sorted and shuffled times
+ * and counts not multiple of the lanes count.
+ */
+static void test_kernels()
+{
+	using namespace curve_x;
+
+	//  37 segments, so that the lengths of each level are computed
+	//  both by full vectors and by the scalar tail
+	Curve curve;
+	for ( int key_id = 0; key_id < 38; key_id++ )
+	{
+		curve.add_key( CurveKey(
+			{ key_id * 0.75f + ( key_id % 2 ) * 0.2f, (float)( key_id % 4 ) },
+			{ -0.2f, 0.3f },
+			{ 0.2f, -0.3f }
+		) );
+	}
+	curve.set_interpolation_mode( 2, InterpolationMode::Constant );
+	curve.set_interpolation_mode( 5, InterpolationMode::Linear );
+	curve.set_interpolation_mode( 33, InterpolationMode::Constant );
+	const CompiledCurve compiled_curve = curve.compile();
+
+	//  Times go a bit out of the curve, on both sides
+	const float start_time = compiled_curve.get_key_time( 0 ) - 0.5f;
+	const float end_time =
+		compiled_curve.get_key_time( compiled_curve.get_keys_count() - 1 ) + 0.5f;
+
+	const SimdLevel detected_level = CurveKernels::detect_simd_level();
+	const int counts[] { 1, 7, 13, 1003 };
+	std::mt19937 random( 42 );
+	for ( int count : counts )
+	{
+		std::vector<float> sorted_times( count );
+		for ( int i = 0; i < count; i++ )
+		{
+			sorted_times[i] = start_time
+				+ ( end_time - start_time ) * i / std::max( count - 1, 1 );
+		}
+		std::vector<float> shuffled_times = sorted_times;
+		std::shuffle( shuffled_times.begin(), shuffled_times.end(), random );
+
+		//  Compute the references with the scalar implementation
+		assert( CurveKernels::set_simd_level( SimdLevel::Scalar ) );
+		std::vector<float> sorted_values( count ), shuffled_values( count );
+		CurveKernels::evaluate_by_time( compiled_curve,
+			sorted_times.data(), sorted_values.data(), count );
+		CurveKernels::evaluate_by_time( compiled_curve,
+			shuffled_times.data(), shuffled_values.data(), count );
+		std::vector<Point> points( count );
+		CurveKernels::tessellate( compiled_curve, count, points.data() );
+		const float length = CurveKernels::compute_length( compiled_curve );
+
+		for ( int level_id = (int)SimdLevel::SSE42;
+			level_id <= (int)detected_level; level_id++ )
+		{
+			assert( CurveKernels::set_simd_level( (SimdLevel)level_id ) );
+
+			std::vector<float> values( count );
+			CurveKernels::evaluate_by_time( compiled_curve,
+				sorted_times.data(), values.data(), count );
+			for ( int i = 0; i < count; i++ )
+			{
+				assert( fabsf( values[i] - sorted_values[i] ) < 1e-5f );
+			}
+
+			CurveKernels::evaluate_by_time( compiled_curve,
+				shuffled_times.data(), values.data(), count );
+			for ( int i = 0; i < count; i++ )
+			{
+				assert( fabsf( values[i] - shuffled_values[i] ) < 1e-5f );
+			}
+
+			std::vector<Point> level_points( count );
+			CurveKernels::tessellate( compiled_curve, count, level_points.data() );
+			for ( int i = 0; i < count; i++ )
+			{
+				assert( ( level_points[i] - points[i] ).length() < 1e-5f );
+			}
+
+			//  Lengths are summed in a different order
+			assert( fabsf( CurveKernels::compute_length( compiled_curve )
+				- length ) < length * 1e-5f );
+		}
+	}
+
+	CurveKernels::set_simd_level( detected_level );
+}
+
+/*
+ * Edit, insert and remove keys of a curve, including its first and
+ * last keys, whose incrementally updated cache must match the one
+ * of a freshly built curve.
+ */
+static void test_segments_cache()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	for ( int key_id = 0; key_id < 6; key_id++ )
+	{
+		curve.add_key( CurveKey( 
+			{ (float)key_id, (float)key_id * 0.5f },
+			{ -0.25f, 0.0f },
+			{ 0.25f, 0.0f }
+		) );
+	}
+
+	auto check_cache = [&]()
+	{
+		Curve fresh_curve;
+		for ( int key_id = 0; key_id < curve.get_keys_count(); key_id++ )
+		{
+			fresh_curve.add_key( curve.get_key( key_id ) );
+		}
+
+		const CurveExtrems bounds = curve.get_bounds();
+		const CurveExtrems fresh_bounds = fresh_curve.get_bounds();
+		assert( bounds.min_x == fresh_bounds.min_x );
+		assert( bounds.max_x == fresh_bounds.max_x );
+		assert( fabsf( bounds.min_y - fresh_bounds.min_y ) < 1e-5f );
+		assert( fabsf( bounds.max_y - fresh_bounds.max_y ) < 1e-5f );
+
+		assert( curve.get_monotonicity() == fresh_curve.get_monotonicity() );
+
+		//  Integrate across the whole curve and from within segments
+		const float ranges[][2] { 
+			{ -1.0f, 10.0f }, { 0.3f, 2.7f }, { 1.5f, 1.75f }, { 4.2f, 0.1f } 
+		};
+		for ( const auto& range : ranges )
+		{
+			assert( fabsf( curve.integrate( range[0], range[1] ) 
+				- fresh_curve.integrate( range[0], range[1] ) ) < 1e-4f );
+		}
+	};
+	check_cache();
+	assert( curve.get_monotonicity() == Monotonicity::Increasing );
+
+	//  Edit the first and last keys, and a tangent in between
+	curve.set_point( 0, Point( 0.0f, 2.0f ) );
+	check_cache();
+	assert( curve.get_monotonicity() == Monotonicity::None );
+	curve.set_point( curve.key_to_point_id( 5 ), Point( 5.0f, 4.0f ) );
+	check_cache();
+	curve.set_point( 4, Point( 0.25f, 1.0f ) );
+	check_cache();
+	curve.set_interpolation_mode( 2, InterpolationMode::Constant );
+	check_cache();
+
+	//  Insert keys at the start, the end and in between
+	curve.insert_key( 0, CurveKey( { -1.0f, -1.0f } ) );
+	check_cache();
+	curve.add_key( CurveKey( { 7.0f, 0.0f } ) );
+	check_cache();
+	curve.insert_key( 3, CurveKey( { 1.5f, 3.0f } ) );
+	check_cache();
+
+	//  Remove keys at the start, the end and in between
+	curve.remove_key( 0 );
+	check_cache();
+	curve.remove_key( curve.get_keys_count() - 1 );
+	check_cache();
+	curve.remove_key( 2 );
+	check_cache();
+	curve.remove_key( 0 );
+	check_cache();
+
+	//  Bounds of small-scale segments scale with them
+	for ( float scale : { 1.0f, 1e-8f } )
+	{
+		Curve small_curve;
+		small_curve.add_key( CurveKey( 
+			{ 0.0f, 0.0f }, { -scale / 3.0f, 0.0f }, { scale / 3.0f, scale } ) );
+		small_curve.add_key( CurveKey( 
+			{ scale, 0.0f }, { -scale / 3.0f, scale }, { scale / 3.0f, 0.0f } ) );
+
+		const CurveExtrems bounds = small_curve.get_bounds();
+		assert( fabsf( bounds.max_y / scale - 0.75f ) < 1e-4f );
+		assert( bounds.min_y == 0.0f );
+	}
+}
+
+/*
+ * Returns whenever both curves have exactly the same keys.
+ */
+static bool is_same_keys( const curve_x::Curve& a, const curve_x::Curve& b )
+{
+	if ( a.get_keys_count() != b.get_keys_count() ) return false;
+
+	for ( int key_id = 0; key_id < a.get_keys_count(); key_id++ )
+	{
+		const curve_x::CurveKey& key_a = a.get_key( key_id );
+		const curve_x::CurveKey& key_b = b.get_key( key_id );
+		if ( !( key_a.control == key_b.control )
+		  || !( key_a.left_tangent == key_b.left_tangent )
+		  || !( key_a.right_tangent == key_b.right_tangent )
+		  || key_a.tangent_mode != key_b.tangent_mode
+		  || key_a.interpolation_mode != key_b.interpolation_mode ) return false;
+	}
+
+	return true;
+}
+
+/*
+ * Record and apply patches, which must edit curves the same way 
+ * as their mutators, or not at all when invalid.
+ */
+static void test_patches()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f } ) );
+	curve.add_key( CurveKey( { 1.0f, 1.0f } ) );
+	curve.add_key( CurveKey( { 2.0f, 0.0f } ) );
+	Curve expected_curve = curve;
+
+	//  Record each kind of operation, doing the same directly
+	CurvePatch patch;
+	patch.set_point( 3, Point( 1.0f, 2.0f ) );
+	expected_curve.set_point( 3, Point( 1.0f, 2.0f ) );
+	patch.set_tangent_point( 4, Point( 0.5f, 0.25f ) );
+	expected_curve.set_tangent_point( 4, Point( 0.5f, 0.25f ) );
+	patch.set_tangent_point( 2, Point( -0.5f, 1.0f ), PointSpace::Global );
+	expected_curve.set_tangent_point( 2, Point( -0.5f, 1.0f ), PointSpace::Global );
+
+	const CurveKey key( { 1.5f, -1.0f }, { -0.1f, 0.2f }, { 0.3f, 0.4f },
+		TangentMode::Broken, InterpolationMode::Linear );
+	patch.insert_key( 2, key );
+	expected_curve.insert_key( 2, key );
+	patch.remove_key( 0 );
+	expected_curve.remove_key( 0 );
+	patch.set_tangent_mode( 1, TangentMode::Aligned, false );
+	expected_curve.set_tangent_mode( 1, TangentMode::Aligned, false );
+	patch.set_tangent_mode( 0, TangentMode::Mirrored );
+	expected_curve.set_tangent_mode( 0, TangentMode::Mirrored );
+	patch.set_interpolation_mode( 2, InterpolationMode::Constant );
+	expected_curve.set_interpolation_mode( 2, InterpolationMode::Constant );
+	assert( patch.get_operations_count() == 8 );
+
+	//  Patches apply from their object and from their data
+	Curve patched_curve = curve;
+	patch.apply( &patched_curve );
+	assert( is_same_keys( patched_curve, expected_curve ) );
+
+	patched_curve = curve;
+	const std::vector<uint8_t>& data = patch.get_data();
+	assert( CurvePatch::get_patch_size( data.data() ) == data.size() );
+	assert( CurvePatch::apply( &patched_curve, data.data(), data.size() ) == 8 );
+	assert( is_same_keys( patched_curve, expected_curve ) );
+
+	//  A later invalid operation leaves the curve unchanged
+	patch.clear();
+	patch.set_point( 0, Point( 0.0f, 5.0f ) );
+	patch.remove_key( 1 );
+	patch.set_point( 9, Point( 3.0f, 5.0f ) );
+
+	patched_curve = curve;
+	assert( is_throwing( [&]() { patch.apply( &patched_curve ); } ) );
+	assert( is_same_keys( patched_curve, curve ) );
+
+	//  So does a truncated patch
+	std::vector<uint8_t> truncated_data = patch.get_data();
+	truncated_data.pop_back();
+	assert( is_throwing( [&]() { 
+		CurvePatch::apply( &patched_curve, truncated_data.data(), truncated_data.size() ); 
+	} ) );
+	assert( is_same_keys( patched_curve, curve ) );
+}
+
+/*
+ * Simplify a densely keyed curve, which must lose keys while 
+ * staying within the tolerance of the original curve.
+ */
+static void test_simplify()
+{
+	using namespace curve_x;
+
+	//  Key a sine wave every 0.05, with tangents along its slope
+	constexpr int KEYS_COUNT = 101;
+	constexpr float STEP = 0.05f;
+	constexpr float TOLERANCE = 0.01f;
+
+	Curve curve;
+	for ( int key_id = 0; key_id < KEYS_COUNT; key_id++ )
+	{
+		const float x = key_id * STEP;
+		const Point tangent( STEP / 3.0f, cosf( x ) * STEP / 3.0f );
+		curve.add_key( CurveKey( 
+			{ x, sinf( x ) }, 
+			tangent * -1.0f, 
+			tangent, 
+			TangentMode::Aligned 
+		) );
+	}
+	const Curve original_curve = curve;
+
+	const CurveSimplification simplification = curve.simplify( TOLERANCE );
+	assert( simplification.removed_keys_count > 0 );
+	assert( curve.get_keys_count() 
+		 == KEYS_COUNT - simplification.removed_keys_count );
+	assert( simplification.time_error <= TOLERANCE );
+	assert( simplification.geometry_error <= TOLERANCE );
+
+	//  Ends are kept, and the whole curve stays within tolerance
+	assert( curve.get_key( 0 ).control == original_curve.get_key( 0 ).control );
+	assert( curve.get_key( curve.get_keys_count() - 1 ).control 
+		 == original_curve.get_key( KEYS_COUNT - 1 ).control );
+	for ( int i = 0; i <= 1000; i++ )
+	{
+		const float time = ( KEYS_COUNT - 1 ) * STEP * i / 1000.0f;
+		assert( fabsf( curve.evaluate_by_time( time ) 
+			- original_curve.evaluate_by_time( time ) ) <= TOLERANCE );
+	}
+}
+
+/*
+ * Blend curves with aligned and unaligned key times, mixing
+ * interpolation modes, whose evaluations and bake must match the
+ * weighted sum of the curves.
+ */
+static void test_blender()
+{
+	using namespace curve_x;
+
+	//  Create curves with a constant, a linear and a cubic segment,
+	//  in a different order for each curve
+	auto create_curve = []( const float* times, int first_mode_id )
+	{
+		Curve curve;
+		for ( int key_id = 0; key_id < 4; key_id++ )
+		{
+			curve.add_key( CurveKey( 
+				{ times[key_id], (float)( ( key_id + first_mode_id ) % 3 ) },
+				{ -0.2f, 0.5f },
+				{ 0.2f, -0.5f },
+				TangentMode::Broken,
+				(InterpolationMode)( ( key_id + first_mode_id ) % 3 )
+			) );
+		}
+		return curve;
+	};
+	const float times[] { 0.0f, 1.0f, 2.5f, 3.0f };
+	const float other_times[] { 0.4f, 1.7f, 2.2f, 4.0f };
+	const Curve a = create_curve( times, 0 );
+	const Curve b = create_curve( times, 1 );
+	const Curve c = create_curve( other_times, 2 );
+
+	const float weights[] { 0.5f, -0.75f, 1.25f };
+	auto check_blend = [&]( const CurveBlender& blender, 
+		const Curve* const* curves )
+	{
+		auto evaluate_sum = [&]( float time )
+		{
+			float value = 0.0f;
+			for ( int i = 0; i < blender.get_curves_count(); i++ )
+			{
+				value += curves[i]->evaluate_by_time( time ) * weights[i];
+			}
+			return value;
+		};
+
+		//  Sample in and out of the curves, avoiding exact key times
+		//  where constant segments jump
+		constexpr int SAMPLES_COUNT = 203;
+		std::vector<float> sample_times( SAMPLES_COUNT ), values( SAMPLES_COUNT );
+		for ( int i = 0; i < SAMPLES_COUNT; i++ )
+		{
+			sample_times[i] = -0.5f + 5.0f * ( i + 0.5f ) / SAMPLES_COUNT;
+		}
+		blender.evaluate_by_time( sample_times.data(), values.data(), SAMPLES_COUNT );
+
+		const Curve baked_curve = blender.bake();
+		for ( int i = 0; i < SAMPLES_COUNT; i++ )
+		{
+			const float time = sample_times[i];
+			const float value = evaluate_sum( time );
+			assert( fabsf( values[i] - value ) < 1e-5f );
+			assert( fabsf( blender.evaluate_by_time( time ) - value ) < 1e-5f );
+			assert( fabsf( baked_curve.evaluate_by_time( time ) - value ) < 1e-4f );
+		}
+	};
+
+	//  Same key times, evaluated with a single segment search
+	const Curve* aligned_curves[] { &a, &b };
+	const CurveBlender aligned_blender( aligned_curves, weights, 2 );
+	assert( aligned_blender.is_aligned() );
+	check_blend( aligned_blender, aligned_curves );
+
+	//  Other key times, evaluated by walking curves in lockstep
+	const Curve* curves[] { &a, &b, &c };
+	CurveBlender blender;
+	for ( int i = 0; i < 3; i++ )
+	{
+		blender.add_curve( curves[i], weights[i] );
+	}
+	assert( !blender.is_aligned() );
+	check_blend( blender, curves );
+}
+
+/*
+ * Evaluate a curve mixing interpolation modes, which must match 
+ * its compiled curve, always built out-of-line.
+ * 
+ * This file is also built with 'CURVE_X_INLINE_HOT_PATHS' defined,
+ * so that inline evaluations are checked as well.
+ */
+static void test_evaluations()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	for ( int key_id = 0; key_id < 7; key_id++ )
+	{
+		curve.add_key( CurveKey( 
+			{ key_id * 0.5f + ( key_id % 3 ) * 0.1f, (float)( key_id % 2 ) },
+			{ -0.1f, 0.4f },
+			{ 0.1f, -0.4f },
+			TangentMode::Broken,
+			(InterpolationMode)( key_id % 3 )
+		) );
+	}
+	const CompiledCurve compiled_curve = curve.compile();
+
+	for ( int i = 0; i <= 500; i++ )
+	{
+		const float t = i / 500.0f;
+		const float time = -0.5f + t * 4.5f;
+		assert( fabsf( curve.evaluate_by_time( time ) 
+			- compiled_curve.evaluate_by_time( time ) ) < 1e-5f );
+		assert( ( curve.evaluate_by_percent( t ) 
+			- compiled_curve.evaluate_by_percent( t ) ).length() < 1e-5f );
+
+		int first_key_id, last_key_id;
+		curve.find_evaluation_keys_id_by_time( &first_key_id, &last_key_id, time );
+		assert( first_key_id == compiled_curve.find_segment_id_by_time( time ) 
+			 || time <= compiled_curve.get_key_time( 0 ) 
+			 || time >= compiled_curve.get_key_time( curve.get_keys_count() - 1 ) );
+	}
+}
+
+/*
+ * Construct, move and assign curves, and load their keys in bulk,
+ * which must keep the keys and the memory resources.
+ */
+static void test_keys_loading()
+{
+	using namespace curve_x;
+
+	const std::vector<CurveKey> keys {
+		CurveKey( { 0.0f, 0.0f } ),
+		CurveKey( { 1.0f, 2.0f } ),
+		CurveKey( { 2.0f, 1.0f } ),
+	};
+	const Curve reference_curve( keys );
+	const float length = Curve( reference_curve ).get_length();
+
+	//  Moving a vector of keys takes ownership of its memory
+	std::pmr::monotonic_buffer_resource resource;
+	std::pmr::vector<CurveKey> pmr_keys( keys.begin(), keys.end(), &resource );
+	const CurveKey* keys_data = pmr_keys.data();
+	Curve curve( std::move( pmr_keys ) );
+	assert( &curve.get_key( 0 ) == keys_data );
+	assert( curve.get_memory_resource() == &resource );
+	assert( is_same_keys( curve, reference_curve ) );
+
+	//  Moving a curve keeps its keys and their resource
+	Curve moved_curve( std::move( curve ) );
+	assert( &moved_curve.get_key( 0 ) == keys_data );
+	assert( moved_curve.get_memory_resource() == &resource );
+	assert( moved_curve.get_length() == length );
+
+	//  Keys are only moved by assignment between curves of the 
+	//  same resource, as for 'std::pmr::vector'
+	Curve move_assigned_curve( &resource );
+	move_assigned_curve = std::move( moved_curve );
+	assert( &move_assigned_curve.get_key( 0 ) == keys_data );
+	assert( is_same_keys( move_assigned_curve, reference_curve ) );
+
+	//  Copies are allocated from the default resource
+	const Curve copy( move_assigned_curve );
+	assert( copy.get_memory_resource() == std::pmr::get_default_resource() );
+	assert( is_same_keys( copy, reference_curve ) );
+
+	Curve copy_assigned_curve;
+	copy_assigned_curve.add_key( CurveKey( { 5.0f, 5.0f } ) );
+	copy_assigned_curve = copy;
+	assert( is_same_keys( copy_assigned_curve, reference_curve ) );
+	assert( copy_assigned_curve.get_length() == length );
+
+	//  Bulk loading gives the same keys as adding them one by one,
+	//  and invalidates the cached data
+	Curve loaded_curve;
+	loaded_curve.reserve( 8 );
+	assert( loaded_curve.get_capacity() >= 8 );
+	loaded_curve.add_key( CurveKey( { -1.0f, 0.0f } ) );
+	loaded_curve.add_key( CurveKey( { 0.0f, 3.0f } ) );
+	const float old_length = loaded_curve.get_length();
+	loaded_curve.assign_keys( keys.data(), (int)keys.size() );
+	assert( is_same_keys( loaded_curve, reference_curve ) );
+	assert( loaded_curve.get_length() == length && length != old_length );
+
+	loaded_curve.assign_keys( keys.data(), 1 );
+	loaded_curve.insert_keys( 1, keys.begin() + 1, keys.end() );
+	assert( is_same_keys( loaded_curve, reference_curve ) );
+
+	loaded_curve.assign_keys( keys.data(), 1 );
+	loaded_curve.emplace_key( Point( 1.0f, 2.0f ) );
+	loaded_curve.emplace_key( Point( 2.0f, 1.0f ) );
+	assert( is_same_keys( loaded_curve, reference_curve ) );
+
+	//  Keys inserted by time are merged in order
+	Curve sorted_curve;
+	sorted_curve.insert_keys_by_time( keys.rbegin(), keys.rend() - 1 );
+	assert( sorted_curve.insert_key_by_time( keys[0] ) == 0 );
+	assert( is_same_keys( sorted_curve, reference_curve ) );
+
+	loaded_curve.shrink_to_fit();
+	assert( loaded_curve.get_capacity() == loaded_curve.get_keys_count() );
+}
+
+/*
+ * Serialize a multi-channel curve with broken tangents, which must
+ * be un-serialized with the same keys, channel by channel.
+ */
+static void test_multi_curve_serialize()
+{
+	using namespace curve_x;
+
+	constexpr int CHANNELS_COUNT = 3;
+	MultiCurve multi_curve( CHANNELS_COUNT );
+	for ( int key_id = 0; key_id < 4; key_id++ )
+	{
+		float values[CHANNELS_COUNT];
+		Point left_tangents[CHANNELS_COUNT], right_tangents[CHANNELS_COUNT];
+		for ( int channel = 0; channel < CHANNELS_COUNT; channel++ )
+		{
+			values[channel] = key_id * 0.25f - channel * 0.125f;
+			left_tangents[channel] = Point( -0.25f, channel * 0.5f );
+			right_tangents[channel] = Point( 0.125f, key_id * -0.75f );
+		}
+
+		multi_curve.add_key( key_id * 0.5f, values, 
+			left_tangents, right_tangents, TangentMode::Broken );
+	}
+
+	CurveSerializer serializer;
+	const std::string data = serializer.serialize( multi_curve );
+	const MultiCurve copy = serializer.unserialize_multi( data );
+	assert( serializer.serialize( copy ) == data );
+
+	assert( copy.get_channels_count() == CHANNELS_COUNT );
+	assert( copy.get_keys_count() == multi_curve.get_keys_count() );
+	for ( int key_id = 0; key_id < copy.get_keys_count(); key_id++ )
+	{
+		assert( copy.get_key_time( key_id ) == multi_curve.get_key_time( key_id ) );
+		assert( copy.get_tangent_mode( key_id ) == TangentMode::Broken );
+
+		for ( int channel = 0; channel < CHANNELS_COUNT; channel++ )
+		{
+			assert( copy.get_value( key_id, channel ) 
+				 == multi_curve.get_value( key_id, channel ) );
+			assert( copy.get_left_tangent( key_id, channel ) 
+				 == multi_curve.get_left_tangent( key_id, channel ) );
+			assert( copy.get_right_tangent( key_id, channel ) 
+				 == multi_curve.get_right_tangent( key_id, channel ) );
+		}
+	}
+
+	//  Channels evaluate like the curves extracted from them
+	for ( int channel = 0; channel < CHANNELS_COUNT; channel++ )
+	{
+		const Curve curve = copy.extract_channel( channel );
+		for ( float time = -0.25f; time <= 1.75f; time += 0.0625f )
+		{
+			float values[CHANNELS_COUNT];
+			copy.evaluate_by_time( time, values );
+			assert( fabsf( values[channel] - curve.evaluate_by_time( time ) ) 
+				< 0.0001f );
+		}
+	}
+
+	//  Malformed data
+	const char* invalid_data[] {
+		"version:2\nchannels:1\n0:garbage|y=1.000000,zz\n",
+		"version:2\nchannels:1\n0:x=0.000000,0,2|y=1.000000,zz\n",
+		"version:2\nchannels:1\n0:x=0.000000,0,2|y=1.000000,x=-1.000000;y=0.000000\n",
+		"version:2\nchannels:1\n0:x=0.000000,3,2|y=1.000000,x=-1.000000;y=0.000000,x=1.000000;y=0.000000\n",
+		"version:2\nchannels:1\n0:x=0.000000,0,3|y=1.000000,x=-1.000000;y=0.000000,x=1.000000;y=0.000000\n",
+	};
+	for ( const char* invalid : invalid_data )
+	{
+		assert( is_throwing( [&]() { serializer.unserialize_multi( invalid ); } ) );
+	}
+}
+
+/*
+ * Evaluate the derivatives of a curve, which must match finite 
+ * differences of its evaluations, away from its keys.
+ */
+static void test_derivatives()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f }, { -0.3f, 0.0f }, { 0.3f, 0.9f } ) );
+	curve.add_key( CurveKey( { 1.0f, 1.0f }, { -0.4f, 0.2f }, { 0.4f, -0.2f } ) );
+	curve.add_key( CurveKey( { 2.0f, -0.5f }, { -0.2f, -0.6f }, { 0.2f, 0.6f } ) );
+
+	//  Central differences, of which errors grow with the step 
+	//  squared and with the float rounding over the step
+	constexpr float H = 1e-3f;
+	auto is_near = []( float a, float b ) 
+	{
+		return fabsf( a - b ) < 0.01f * ( 1.0f + fabsf( b ) );
+	};
+
+	const float times[] { 0.1f, 0.45f, 0.8f, 1.3f, 1.9f };
+	for ( float time : times )
+	{
+		const float derivative = curve.evaluate_derivative_by_time( time );
+		const float second_derivative = curve.evaluate_second_derivative_by_time( time );
+		assert( is_near( derivative, ( curve.evaluate_by_time( time + H ) 
+			- curve.evaluate_by_time( time - H ) ) / ( 2.0f * H ) ) );
+		assert( is_near( second_derivative, 
+			( curve.evaluate_derivative_by_time( time + H ) 
+			- curve.evaluate_derivative_by_time( time - H ) ) / ( 2.0f * H ) ) );
+		assert( is_near( curve.evaluate_curvature_by_time( time ), 
+			second_derivative / powf( 1.0f + derivative * derivative, 1.5f ) ) );
+
+		float value, batch_derivative;
+		curve.evaluate_with_derivative_by_time( time, &value, &batch_derivative );
+		assert( value == curve.evaluate_by_time( time ) );
+		assert( batch_derivative == derivative );
+	}
+
+	//  Slopes are null outside of the keys
+	assert( curve.evaluate_derivative_by_time( -1.0f ) == 0.0f );
+	assert( curve.evaluate_derivative_by_time( 3.0f ) == 0.0f );
+
+	const float percents[] { 0.1f, 0.3f, 0.7f, 0.95f };
+	for ( float t : percents )
+	{
+		const Point derivative = curve.evaluate_derivative_by_percent( t );
+		const Point second_derivative = curve.evaluate_second_derivative_by_percent( t );
+		const Point difference = ( curve.evaluate_by_percent( t + H ) 
+			- curve.evaluate_by_percent( t - H ) ) * ( 0.5f / H );
+		const Point second_difference = ( curve.evaluate_derivative_by_percent( t + H ) 
+			- curve.evaluate_derivative_by_percent( t - H ) ) * ( 0.5f / H );
+		assert( is_near( derivative.x, difference.x ) );
+		assert( is_near( derivative.y, difference.y ) );
+		assert( is_near( second_derivative.x, second_difference.x ) );
+		assert( is_near( second_derivative.y, second_difference.y ) );
+
+		const float speed = derivative.length();
+		assert( is_near( curve.evaluate_curvature_by_percent( t ), 
+			( derivative.x * second_derivative.y - derivative.y * second_derivative.x ) 
+				/ ( speed * speed * speed ) ) );
+	}
+}
+
+/*
+ * Integrate a curve mixing interpolation modes, which must match a
+ * numeric sum of its evaluations, inside and outside of its keys.
+ */
+static void test_integrate()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	for ( int key_id = 0; key_id < 6; key_id++ )
+	{
+		curve.add_key( CurveKey( 
+			{ key_id * 0.8f, (float)( key_id % 3 ) - 0.5f },
+			{ -0.2f, 0.6f },
+			{ 0.2f, -0.6f },
+			TangentMode::Mirrored,
+			(InterpolationMode)( key_id % 3 )
+		) );
+	}
+
+	//  Midpoint sum, accumulated in double precision
+	auto sum_values = [&]( float start_time, float end_time )
+	{
+		constexpr int STEPS_COUNT = 20000;
+		const double step = ( (double)end_time - start_time ) / STEPS_COUNT;
+
+		double sum = 0.0;
+		for ( int i = 0; i < STEPS_COUNT; i++ )
+		{
+			sum += curve.evaluate_by_time( (float)( start_time + ( i + 0.5 ) * step ) );
+		}
+		return (float)( sum * step );
+	};
+
+	const float ranges[][2] {
+		{ 0.0f, 4.0f }, { -1.0f, 5.0f }, { 0.3f, 0.5f }, 
+		{ 1.1f, 3.7f }, { 4.5f, 6.0f }, { 3.0f, 0.2f },
+	};
+	for ( const auto& range : ranges )
+	{
+		const float integral = curve.integrate( range[0], range[1] );
+		assert( fabsf( integral - sum_values( range[0], range[1] ) ) < 1e-3f );
+
+		//  The const overload uses the now computed cache
+		assert( std::as_const( curve ).integrate( range[0], range[1] ) == integral );
+	}
+
+	assert( curve.integrate( 2.0f, 2.0f ) == 0.0f );
+
+	//  A single key is integrated as a constant
+	Curve key_curve;
+	key_curve.add_key( CurveKey( { 0.0f, 2.0f } ) );
+	assert( key_curve.integrate( -1.0f, 1.0f ) == 4.0f );
+	assert( key_curve.integrate( 0.5f, 1.0f ) == 1.0f );
+	assert( std::as_const( key_curve ).integrate( -1.0f, 0.0f ) == 2.0f );
+}
+
+/*
+ * Invert monotonic curves by time, which must give back the times
+ * evaluated to the given values.
+ */
+static void test_inverse_evaluate()
+{
+	using namespace curve_x;
+
+	//  Increasing curve, flat on its second segment
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f }, { -0.2f, 0.0f }, { 0.2f, 0.1f } ) );
+	curve.add_key( CurveKey( { 1.0f, 1.0f }, { -0.3f, -0.2f }, { 0.3f, 0.0f } ) );
+	curve.add_key( CurveKey( { 2.0f, 1.0f }, { -0.3f, 0.0f }, { 0.3f, 0.0f } ) );
+	curve.add_key( CurveKey( { 3.0f, 2.5f } ) );
+	curve.set_interpolation_mode( 1, InterpolationMode::Constant );
+	curve.set_interpolation_mode( 2, InterpolationMode::Linear );
+	assert( curve.get_monotonicity() == Monotonicity::Increasing );
+
+	for ( float time = 0.0f; time <= 3.0f; time += 0.0625f )
+	{
+		const float value = curve.evaluate_by_time( time );
+
+		float inverse_time;
+		assert( curve.inverse_evaluate_by_time( value, &inverse_time ) );
+		assert( fabsf( curve.evaluate_by_time( inverse_time ) - value ) < 1e-4f );
+
+		//  Flat regions give their earliest time
+		if ( time <= 1.0f || time > 2.0f )
+		{
+			assert( fabsf( inverse_time - time ) < 1e-3f );
+		}
+		else
+		{
+			assert( fabsf( inverse_time - 1.0f ) < 1e-3f );
+		}
+	}
+
+	//  Values out of the curve range can't be inverted
+	float inverse_time;
+	assert( !curve.inverse_evaluate_by_time( -0.1f, &inverse_time ) );
+	assert( !curve.inverse_evaluate_by_time( 2.6f, &inverse_time ) );
+
+	//  Decreasing curves are inverted as well
+	Curve decreasing_curve;
+	decreasing_curve.add_key( CurveKey( { 0.0f, 1.0f } ) );
+	decreasing_curve.add_key( CurveKey( { 2.0f, -1.0f } ) );
+	assert( decreasing_curve.get_monotonicity() == Monotonicity::Decreasing );
+	assert( decreasing_curve.inverse_evaluate_by_time( 
+		decreasing_curve.evaluate_by_time( 0.7f ), &inverse_time ) );
+	assert( fabsf( inverse_time - 0.7f ) < 1e-3f );
+
+	//  Non-monotonic curves can't be inverted
+	curve.add_key( CurveKey( { 4.0f, 0.0f } ) );
+	assert( curve.get_monotonicity() == Monotonicity::None );
+	assert( !curve.inverse_evaluate_by_time( 0.5f, &inverse_time ) );
+}
+
+/*
+ * Find crossings and local extrems of a wavy curve, which must match 
+ * the sign changes of dense samples of its values and slopes.
+ */
+static void test_crossings_and_extrems()
+{
+	using namespace curve_x;
+
+	//  Keys of a wave, with extrems inside its segments
+	Curve curve;
+	for ( int key_id = 0; key_id < 8; key_id++ )
+	{
+		const float x = key_id * 1.3f;
+		curve.add_key( CurveKey( 
+			{ x, sinf( x ) }, 
+			{ -0.4f, -0.4f * cosf( x ) }, 
+			{ 0.4f, 0.4f * cosf( x ) } 
+		) );
+	}
+	const float start_time = 0.0f, end_time = 7.0f * 1.3f;
+
+	constexpr int SAMPLES_COUNT = 10000;
+	auto get_sample_time = [&]( int i )
+	{
+		return start_time + ( end_time - start_time ) * i / SAMPLES_COUNT;
+	};
+
+	const float values[] { 0.0f, 0.5f, -0.8f };
+	for ( float value : values )
+	{
+		std::vector<float> times;
+		const int count = curve.find_crossings_by_time( 
+			value, start_time, end_time, &times );
+		assert( count == (int)times.size() );
+		assert( std::is_sorted( times.begin(), times.end() ) );
+
+		int sign_changes_count = 0;
+		for ( int i = 0; i < SAMPLES_COUNT; i++ )
+		{
+			const bool is_above = curve.evaluate_by_time( get_sample_time( i ) ) >= value;
+			const bool is_next_above = 
+				curve.evaluate_by_time( get_sample_time( i + 1 ) ) >= value;
+			if ( is_above != is_next_above ) sign_changes_count++;
+		}
+		assert( count == sign_changes_count && count > 0 );
+
+		for ( float time : times )
+		{
+			assert( fabsf( curve.evaluate_by_time( time ) - value ) < 1e-3f );
+		}
+	}
+
+	std::vector<float> extrems;
+	const int extrems_count = curve.find_local_extrems_by_time( 
+		start_time, end_time, &extrems );
+	assert( std::is_sorted( extrems.begin(), extrems.end() ) );
+
+	int slope_changes_count = 0;
+	for ( int i = 1; i < SAMPLES_COUNT - 1; i++ )
+	{
+		const float previous_value = curve.evaluate_by_time( get_sample_time( i - 1 ) );
+		const float value = curve.evaluate_by_time( get_sample_time( i ) );
+		const float next_value = curve.evaluate_by_time( get_sample_time( i + 1 ) );
+		if ( ( value - previous_value ) * ( next_value - value ) < 0.0f ) 
+		{
+			slope_changes_count++;
+		}
+	}
+	assert( extrems_count == slope_changes_count && extrems_count > 0 );
+
+	for ( float time : extrems )
+	{
+		assert( time > start_time && time < end_time );
+		assert( fabsf( curve.evaluate_derivative_by_time( time ) ) < 1e-3f );
+	}
+}
+
+/*
+ * Distribute points along a curve, which must be evenly spaced
+ * from its start to its end, with unit tangents along the curve.
+ */
+static void test_distribute_by_distance()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f }, { -0.5f, 0.0f }, { 0.5f, 1.0f } ) );
+	curve.add_key( CurveKey( { 1.5f, 1.0f }, { -0.5f, 0.5f }, { 0.5f, -0.5f } ) );
+	curve.add_key( CurveKey( { 3.0f, -0.5f }, { -0.5f, 0.0f }, { 0.5f, 0.0f } ) );
+	curve.add_key( CurveKey( { 4.0f, 0.5f } ) );
+	curve.set_interpolation_mode( 2, InterpolationMode::Linear );
+
+	constexpr int COUNT = 40;
+	constexpr float STEPS = 1.0f / 1000.0f;
+	Point points[COUNT], tangents[COUNT];
+	curve.distribute_by_distance( COUNT, points, tangents, STEPS );
+
+	//  Ends are the first and last keys
+	assert( ( points[0] - curve.get_key( 0 ).control ).length() < 1e-4f );
+	assert( ( points[COUNT - 1] - curve.get_key( 3 ).control ).length() < 1e-3f );
+
+	//  Chords between points are close to their arc length, as 
+	//  points are close enough compared to the curvature. Paths
+	//  go through the keys between points, cutting no corner.
+	curve.compute_length( STEPS );
+	const float spacing = curve.get_length() / ( COUNT - 1 );
+	for ( int i = 0; i < COUNT - 1; i++ )
+	{
+		float distance = 0.0f;
+		Point point = points[i];
+		for ( int key_id = 0; key_id < curve.get_keys_count(); key_id++ )
+		{
+			const Point& control = curve.get_key( key_id ).control;
+			if ( control.x <= points[i].x || control.x >= points[i + 1].x ) continue;
+
+			distance += ( control - point ).length();
+			point = control;
+		}
+		distance += ( points[i + 1] - point ).length();
+
+		assert( fabsf( distance - spacing ) < spacing * 0.01f );
+	}
+
+	for ( int i = 0; i < COUNT; i++ )
+	{
+		assert( fabsf( tangents[i].length() - 1.0f ) < 1e-4f );
+
+		//  Tangents follow the neighbour points
+		const Point direction = ( points[std::min( i + 1, COUNT - 1 )] 
+			- points[std::max( i - 1, 0 )] ).normalized();
+		assert( tangents[i].x * direction.x + tangents[i].y * direction.y > 0.95f );
+	}
+}
+
+/*
+ * Quantize a curve, which must stay within its reported errors when
+ * sampled more densely than they were measured.
+ */
+static void test_quantized_curve()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	for ( int key_id = 0; key_id < 12; key_id++ )
+	{
+		const float x = key_id * 0.7f;
+		curve.add_key( CurveKey( 
+			{ x, 3.0f * sinf( x ) },
+			{ -0.2f, -0.6f * cosf( x ) },
+			{ 0.25f, 0.75f * cosf( x ) },
+			TangentMode::Broken,
+			key_id % 4 == 3 ? InterpolationMode::Linear : InterpolationMode::Cubic
+		) );
+	}
+
+	const QuantizedCurve quantized_curve( curve );
+	assert( quantized_curve.get_keys_count() == curve.get_keys_count() );
+	assert( quantized_curve.get_memory_usage() < QuantizedCurve::get_memory_usage( curve ) );
+
+	//  Errors are about the quantization steps of the values
+	const float time_error = quantized_curve.get_time_error();
+	const float geometry_error = quantized_curve.get_geometry_error();
+	assert( time_error > 0.0f && time_error < 6.0f / 65535.0f * 8.0f );
+	assert( geometry_error > 0.0f && geometry_error < 6.0f / 65535.0f * 8.0f );
+
+	//  Errors measured on samples may be slightly exceeded between
+	//  them, by less than the error variation over a sample
+	constexpr int SAMPLES_COUNT = 50000;
+	const float end_time = curve.get_key( curve.get_keys_count() - 1 ).control.x;
+	for ( int i = 0; i <= SAMPLES_COUNT; i++ )
+	{
+		const float t = (float)i / SAMPLES_COUNT;
+		assert( fabsf( quantized_curve.evaluate_by_time( t * end_time ) 
+			- curve.evaluate_by_time( t * end_time ) ) <= time_error * 1.05f );
+		assert( ( quantized_curve.evaluate_by_percent( t ) 
+			- curve.evaluate_by_percent( t ) ).length() <= geometry_error * 1.05f );
+	}
+
+	//  Modes are kept as-is
+	for ( int key_id = 0; key_id < curve.get_keys_count(); key_id++ )
+	{
+		const CurveKey key = quantized_curve.decode_key( key_id );
+		assert( key.tangent_mode == curve.get_key( key_id ).tangent_mode );
+		assert( key.interpolation_mode == curve.get_key( key_id ).interpolation_mode );
+	}
+}
+
+/*
+ * Play tracks with each wrap mode, whose values must follow their
+ * wrapped times, on one thread or on several.
+ */
+static void test_track_scheduler()
+{
+	using namespace curve_x;
+
+	Curve curve;
+	curve.add_key( CurveKey( { 1.0f, 0.0f } ) );
+	curve.add_key( CurveKey( { 2.0f, 2.0f } ) );
+	curve.add_key( CurveKey( { 3.0f, 1.0f } ) );
+	const CompiledCurve compiled_curve = curve.compile();
+	constexpr float DURATION = 2.0f;
+
+	//  Expected time of a track, relative to the first key
+	auto wrap_time = []( float time, float start_time, TrackWrapMode wrap_mode )
+	{
+		//  Delayed tracks have not started yet
+		if ( start_time < 0.0f && time < 0.0f ) return time;
+
+		switch ( wrap_mode )
+		{
+			case TrackWrapMode::Clamp:
+				return fminf( time, DURATION );
+			case TrackWrapMode::Loop:
+			{
+				const float loop_time = fmodf( time, DURATION );
+				return loop_time < 0.0f ? loop_time + DURATION : loop_time;
+			}
+			default:
+			{
+				float ping_pong_time = fmodf( time, 2.0f * DURATION );
+				if ( ping_pong_time < 0.0f ) ping_pong_time += 2.0f * DURATION;
+				return ping_pong_time > DURATION 
+					? 2.0f * DURATION - ping_pong_time 
+					: ping_pong_time;
+			}
+		}
+	};
+
+	struct TrackParameters
+	{
+		float time, speed;
+		TrackWrapMode wrap_mode;
+	};
+	const TrackParameters tracks[] {
+		{ 0.0f, 1.0f, TrackWrapMode::Clamp },
+		{ 0.0f, 1.0f, TrackWrapMode::Loop },
+		{ 0.0f, 1.0f, TrackWrapMode::PingPong },
+		{ -0.5f, 2.0f, TrackWrapMode::Loop },
+		{ 0.25f, 0.5f, TrackWrapMode::PingPong },
+		{ 1.0f, -1.0f, TrackWrapMode::Loop },
+		{ 0.5f, -0.75f, TrackWrapMode::PingPong },
+	};
+	constexpr int TRACKS_COUNT = sizeof( tracks ) / sizeof( TrackParameters );
+
+	CurveTrackScheduler scheduler;
+	for ( const TrackParameters& track : tracks )
+	{
+		scheduler.add_track( &compiled_curve, track.time, track.speed, track.wrap_mode );
+	}
+
+	float values[TRACKS_COUNT];
+	constexpr float DELTA_TIME = 0.125f;
+	for ( int tick = 1; tick <= 40; tick++ )
+	{
+		scheduler.advance( DELTA_TIME, values );
+		for ( int track_id = 0; track_id < TRACKS_COUNT; track_id++ )
+		{
+			const TrackParameters& track = tracks[track_id];
+			const float time = wrap_time( 
+				track.time + tick * DELTA_TIME * track.speed, track.time, 
+				track.wrap_mode );
+			assert( fabsf( values[track_id] 
+				- compiled_curve.evaluate_by_time( 1.0f + time ) ) < 1e-4f );
+
+			//  Ping-pong times are stored before being mirrored
+			if ( track.wrap_mode != TrackWrapMode::PingPong )
+			{
+				assert( fabsf( scheduler.get_track_time( track_id ) - time ) < 1e-4f );
+			}
+		}
+
+		//  Only clamped tracks finish
+		assert( scheduler.is_track_finished( 0 ) == ( tick * DELTA_TIME >= DURATION ) );
+		assert( !scheduler.is_track_finished( 1 ) && !scheduler.is_track_finished( 2 ) );
+	}
+
+	//  Removed indices are reused
+	scheduler.remove_track( 1 );
+	assert( !scheduler.is_valid_track( 1 ) );
+	assert( scheduler.add_track( &compiled_curve ) == 1 );
+
+	//  Threads give the same values as a single thread
+	CurveTrackScheduler single_scheduler, threaded_scheduler;
+	for ( int i = 0; i < TRACKS_PER_THREAD_MIN * 3 + 5; i++ )
+	{
+		const TrackParameters& track = tracks[i % TRACKS_COUNT];
+		const float time = track.time + i * 0.001f;
+		single_scheduler.add_track( &compiled_curve, time, track.speed, track.wrap_mode );
+		threaded_scheduler.add_track( &compiled_curve, time, track.speed, track.wrap_mode );
+	}
+
+	const int capacity = single_scheduler.get_tracks_capacity();
+	std::vector<float> single_values( capacity ), threaded_values( capacity );
+	for ( int tick = 0; tick < 10; tick++ )
+	{
+		single_scheduler.advance( 0.3f, single_values.data() );
+		threaded_scheduler.advance( 0.3f, threaded_values.data(), 4 );
+		assert( single_values == threaded_values );
+	}
+}
 
 int main()
 {
@@ -107,6 +1563,48 @@ int main()
 	}
 	printf( "\n" );
 
+	//  Compile the curve into an evaluation-only object, which must
+	//  give the same results as the editable curve
+	curve_x::CompiledCurve compiled_curve = curve.compile();
+	assert( compiled_curve.get_curves_count() == curve.get_curves_count() );
+	for ( float time : times )
+	{
+		float value = curve.evaluate_by_time( time );
+		float compiled_value = compiled_curve.evaluate_by_time( time );
+		assert( fabsf( value - compiled_value ) < 0.0001f );
+	}
+
+	//  Small constant curves can be evaluated at compile-time
+	constexpr curve_x::FixedCurve fixed_curve {
+		curve_x::CurveKey( { 0.0f, 0.0f } ),
+		curve_x::CurveKey( { 1.0f, 1.0f } ),
+	};
+	static_assert( fixed_curve.evaluate_by_time( 0.5f ) == 0.5f, "" );
+	assert( fixed_curve.evaluate_by_time( 0.3f ) 
+		 == fixed_curve.to_curve().evaluate_by_time( 0.3f ) );
+
+	test_evaluations();
+	test_derivatives();
+	test_integrate();
+	test_inverse_evaluate();
+	test_crossings_and_extrems();
+	test_distribute_by_distance();
+	test_quantized_curve();
+	test_track_scheduler();
+	test_unserialize();
+	test_fitter();
+	test_loader();
+	test_multi_curve_modes();
+	test_multi_curve_serialize();
+	test_intersections();
+	test_stroke_cache();
+	test_kernels();
+	test_segments_cache();
+	test_patches();
+	test_keys_loading();
+	test_simplify();
+	test_blender();
+
 	//  Serialize the curve into a string
 	curve_x::CurveSerializer serializer;
 	std::string data = serializer.serialize( curve );
@@ -0,0 +1,123 @@
+#include <curve-x/curve-patch.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/*
+ * Demo of live tuning through patches: a thread plays the tuning
+ * tool, dragging a tangent and sending one patch per drag through
+ * a pipe, while the main thread plays the game, reading and
+ * applying the patches to its curve.
+ */
+
+constexpr int DRAGS_COUNT = 1000;
+
+static bool write_all( int fd, const uint8_t* data, size_t size )
+{
+	while ( size > 0 )
+	{
+		const ssize_t written = write( fd, data, size );
+		if ( written <= 0 ) return false;
+
+		data += written;
+		size -= (size_t)written;
+	}
+	return true;
+}
+
+static bool read_all( int fd, uint8_t* data, size_t size )
+{
+	while ( size > 0 )
+	{
+		const ssize_t count = read( fd, data, size );
+		if ( count <= 0 ) return false;
+
+		data += count;
+		size -= (size_t)count;
+	}
+	return true;
+}
+
+static void run_tool( int fd )
+{
+	using namespace curve_x;
+
+	CurvePatch patch;
+	for ( int i = 0; i < DRAGS_COUNT; i++ )
+	{
+		//  Drag the right tangent of the middle key
+		const float offset = (float)i / DRAGS_COUNT;
+		patch.clear();
+		patch.set_tangent_point( 4, Point( 0.5f, offset ) );
+
+		//  Occasionally, insert and remove a key
+		if ( i % 100 == 99 )
+		{
+			patch.insert_key( 2, CurveKey( { 1.5f, offset } ) );
+			patch.remove_key( 2 );
+		}
+
+		const std::vector<uint8_t>& data = patch.get_data();
+		if ( !write_all( fd, data.data(), data.size() ) ) break;
+	}
+
+	close( fd );
+}
+
+int main()
+{
+	using namespace curve_x;
+	using clock = std::chrono::high_resolution_clock;
+
+	int fds[2];
+	if ( pipe( fds ) != 0 )
+	{
+		perror( "pipe" );
+		return 1;
+	}
+
+	Curve curve;
+	curve.add_key( CurveKey( { 0.0f, 0.0f } ) );
+	curve.add_key( CurveKey( { 1.0f, 1.0f } ) );
+	curve.add_key( CurveKey( { 2.0f, 0.0f } ) );
+
+	std::thread tool( run_tool, fds[1] );
+
+	int patches_count = 0;
+	double apply_time = 0.0;
+	std::vector<uint8_t> data;
+	while ( true )
+	{
+		//  Read the header to know the size of the patch
+		data.resize( PATCH_HEADER_SIZE );
+		if ( !read_all( fds[0], data.data(), PATCH_HEADER_SIZE ) ) break;
+
+		const size_t size = CurvePatch::get_patch_size( data.data() );
+		data.resize( size );
+		if ( !read_all( fds[0], data.data() + PATCH_HEADER_SIZE, size - PATCH_HEADER_SIZE ) ) break;
+
+		//  Apply and evaluate, as the game would do on its next frame
+		auto start = clock::now();
+		CurvePatch::apply( &curve, data.data(), data.size() );
+		const float value = curve.evaluate_by_time( 1.25f );
+		auto end = clock::now();
+
+		apply_time += std::chrono::duration<double, std::micro>( end - start ).count();
+		patches_count++;
+
+		if ( patches_count % 250 == 0 )
+		{
+			printf( "Patch %d: y(1.25)=%f\n", patches_count, value );
+		}
+	}
+
+	tool.join();
+	close( fds[0] );
+
+	printf( "Applied %d patches, %.2f us/patch (apply and evaluate)\n",
+		patches_count, patches_count > 0 ? apply_time / patches_count : 0.0 );
+}
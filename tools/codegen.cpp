@@ -0,0 +1,137 @@
+#include <curve-x/curve-codegen.h>
+#include <curve-x/curve-serializer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+/*
+ * Command-line tool converting curve files into an embeddable
+ * C++ header.
+ *
+ * Usage: curve-x-codegen [--namespace <name>] -o <output.h> <input.cvx>...
+ */
+int main( int argc, char** argv )
+{
+	std::string namespace_name;
+	std::string output_path;
+	std::vector<std::string> input_paths;
+
+	//  Parse arguments
+	for ( int i = 1; i < argc; i++ )
+	{
+		if ( strcmp( argv[i], "--namespace" ) == 0 && i + 1 < argc )
+		{
+			namespace_name = argv[++i];
+			continue;
+		}
+		if ( strcmp( argv[i], "-o" ) == 0 && i + 1 < argc )
+		{
+			output_path = argv[++i];
+			continue;
+		}
+
+		input_paths.emplace_back( argv[i] );
+	}
+
+	if ( output_path.empty() || input_paths.empty() )
+	{
+		fprintf( stderr,
+			"Usage: %s [--namespace <name>] -o <output.h> <input.cvx>...\n",
+			argv[0]
+		);
+		return 1;
+	}
+
+	//  Refuse to overwrite a curve file, likely passed by mistake
+	const std::string curve_extension = "." + curve_x::FORMAT_EXTENSION;
+	if ( output_path.size() >= curve_extension.size()
+	  && output_path.compare(
+			output_path.size() - curve_extension.size(),
+			std::string::npos,
+			curve_extension ) == 0 )
+	{
+		fprintf( stderr, "Refusing to write the header into the curve file '%s'\n",
+			output_path.c_str() );
+		return 1;
+	}
+
+	curve_x::CurveSerializer serializer;
+	std::vector<curve_x::Curve> curves;
+	std::vector<std::string> names;
+
+	//  Load all curves
+	for ( const std::string& path : input_paths )
+	{
+		std::ifstream file( path );
+		if ( !file )
+		{
+			fprintf( stderr, "Failed to open '%s'\n", path.c_str() );
+			return 1;
+		}
+
+		std::stringstream stream;
+		stream << file.rdbuf();
+
+		//  Multi-channel curves have no generated equivalent
+		const std::string data = stream.str();
+		if ( data.find( "\nchannels:" ) != std::string::npos )
+		{
+			fprintf( stderr,
+				"'%s' is a multi-channel curve file, which is unsupported\n",
+				path.c_str() );
+			return 1;
+		}
+
+		try
+		{
+			curves.push_back( serializer.unserialize( data ) );
+		}
+		catch ( const std::exception& exception )
+		{
+			fprintf( stderr, "Failed to parse '%s': %s\n",
+				path.c_str(), exception.what() );
+			return 1;
+		}
+
+		//  Name the curve after its file name, without folders and
+		//  extension
+		std::string name = path;
+		size_t slash = name.find_last_of( "/\\" );
+		if ( slash != std::string::npos )
+		{
+			name = name.substr( slash + 1 );
+		}
+		size_t dot = name.find_last_of( '.' );
+		if ( dot != std::string::npos )
+		{
+			name = name.substr( 0, dot );
+		}
+		name = curve_x::CurveCodeGenerator::to_identifier( name );
+
+		//  Same names would generate conflicting symbols
+		if ( std::find( names.begin(), names.end(), name ) != names.end() )
+		{
+			fprintf( stderr,
+				"'%s' generates the symbol '%s' of a previous file, "
+				"rename one of them\n",
+				path.c_str(), name.c_str() );
+			return 1;
+		}
+		names.push_back( name );
+	}
+
+	//  Generate & write header
+	curve_x::CurveCodeGenerator generator( namespace_name );
+	std::ofstream output( output_path );
+	if ( !output )
+	{
+		fprintf( stderr, "Failed to open '%s'\n", output_path.c_str() );
+		return 1;
+	}
+	output << generator.generate_header( curves, names );
+
+	return 0;
+}